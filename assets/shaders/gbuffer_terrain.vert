@@ -2,6 +2,7 @@
 
 layout (location = 0) in vec3 aPos;// The position variable has attribute position 0
 layout (location = 1) in float aStaticLight;// The position variable has attribute position 1
+layout (location = 2) in float aOcclusion;// Baked per vertex, darkens the corners between blocks
 
 out float vertexLight;
 out float vertexDistance;
@@ -14,6 +15,6 @@ void main() {
     mat4 modelViewMatrix = viewMatrix * modelMatrix;
     gl_Position = projMatrix * modelViewMatrix * vec4(aPos, 1.0);
 
-    vertexLight = aStaticLight;
+    vertexLight = aStaticLight * aOcclusion;
     vertexDistance = length((modelViewMatrix * vec4(aPos, 1.0)).xyz);
 }
\ No newline at end of file
@@ -0,0 +1,238 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <thread>
+
+#include "core/ThreadPool.h"
+#include "events/EventDispatcher.h"
+#include "utils/Logger.h"
+
+namespace bench {
+
+/* State */
+State::State(int64_t iterations, const std::vector<int64_t>& args)
+    : m_Iterations(iterations), m_Remaining(iterations), m_Started(false), m_Running(false), m_Elapsed(0.0), m_ItemsProcessed(0), m_BytesProcessed(0), m_Args(args) {}
+
+bool State::KeepRunning() {
+    if (!m_Started) {
+        m_Started = true;
+        ResumeTiming();
+    }
+    if (!HasError() && m_Remaining-- > 0) return true;
+
+    PauseTiming();
+    return false;
+}
+
+void State::PauseTiming() {
+    if (!m_Running) return;
+    m_Elapsed += std::chrono::duration<double>(Clock::now() - m_Start).count();
+    m_Running = false;
+}
+
+void State::ResumeTiming() {
+    if (m_Running) return;
+    m_Start = Clock::now();
+    m_Running = true;
+}
+
+void State::SkipWithError(const std::string& message) {
+    m_Error = message.empty() ? "error" : message;
+    m_Remaining = 0;
+}
+
+/* Benchmark */
+Benchmark* Benchmark::Arg(int64_t arg) {
+    m_Args.push_back({arg});
+    return this;
+}
+
+Benchmark* Benchmark::Args(std::initializer_list<int64_t> args) {
+    m_Args.emplace_back(args);
+    return this;
+}
+
+Benchmark* Benchmark::Iterations(int64_t iterations) {
+    m_Iterations = iterations;
+    return this;
+}
+
+static std::vector<std::unique_ptr<Benchmark>>& GetRegistry() {
+    static std::vector<std::unique_ptr<Benchmark>> s_Registry;
+    return s_Registry;
+}
+
+Benchmark* RegisterBenchmark(const std::string& name, BenchmarkFunction function) {
+    GetRegistry().push_back(std::make_unique<Benchmark>(name, function));
+    return GetRegistry().back().get();
+}
+
+/* Runner */
+struct RunResult {
+    std::string name;
+    int64_t iterations;
+    double secondsPerIteration;
+    double itemsPerSecond;
+    double bytesPerSecond;
+    std::unordered_map<std::string, double> counters;
+    std::string error;
+};
+
+static RunResult Run(const Benchmark& benchmark, const std::vector<int64_t>& args, double minTime) {
+    std::string name = benchmark.GetName();
+    for (auto arg : args) name += "/" + std::to_string(arg);
+
+    // Grow the iteration count until the timed region lasts at least minTime
+    int64_t iterations = benchmark.GetFixedIterations() > 0 ? benchmark.GetFixedIterations() : 1;
+    while (true) {
+        State state(iterations, args);
+        benchmark.GetFunction()(state);
+
+        double elapsed = state.GetElapsed();
+        if (state.HasError() || benchmark.GetFixedIterations() > 0 || elapsed >= minTime || iterations >= 1000000000) {
+            RunResult result;
+            result.name = name;
+            result.iterations = iterations;
+            result.secondsPerIteration = elapsed / static_cast<double>(iterations);
+            result.itemsPerSecond = elapsed > 0.0 ? static_cast<double>(state.GetItemsProcessed()) / elapsed : 0.0;
+            result.bytesPerSecond = elapsed > 0.0 ? static_cast<double>(state.GetBytesProcessed()) / elapsed : 0.0;
+            result.counters = state.GetCounters();
+            result.error = state.GetError();
+            return result;
+        }
+
+        double multiplier = elapsed > 0.0 ? std::min(minTime * 1.4 / elapsed, 100.0) : 100.0;
+        iterations = std::max(iterations + 1, static_cast<int64_t>(static_cast<double>(iterations) * multiplier));
+    }
+}
+
+static void PrintResult(const RunResult& result) {
+    std::printf("%-48s %14.1f ns %12lld", result.name.c_str(), result.secondsPerIteration * 1e9, static_cast<long long>(result.iterations));
+    if (result.itemsPerSecond > 0.0) std::printf("  items/s=%.4g", result.itemsPerSecond);
+    if (result.bytesPerSecond > 0.0) std::printf("  MB/s=%.1f", result.bytesPerSecond / 1e6);
+    for (const auto& [counter, value] : result.counters) std::printf("  %s=%.4g", counter.c_str(), value);
+    if (!result.error.empty()) std::printf("  ERROR: %s", result.error.c_str());
+    std::printf("\n");
+}
+
+static void WriteJSONString(std::FILE* file, const std::string& str) {
+    std::fputc('"', file);
+    for (char c : str) {
+        if (c == '"' || c == '\\') std::fputc('\\', file);
+        std::fputc(c, file);
+    }
+    std::fputc('"', file);
+}
+
+// Same layout as Google Benchmark's --benchmark_out, so the usual compare tools can diff two runs
+static bool WriteJSON(const std::string& path, const std::vector<RunResult>& results) {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        std::fprintf(stderr, "Cannot open '%s' for writing\n", path.c_str());
+        return false;
+    }
+
+    char date[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    std::fprintf(file, "{\n  \"context\": {\n");
+    std::fprintf(file, "    \"date\": \"%s\",\n", date);
+    std::fprintf(file, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+#ifdef NDEBUG
+    std::fprintf(file, "    \"library_build_type\": \"release\"\n");
+#else
+    std::fprintf(file, "    \"library_build_type\": \"debug\"\n");
+#endif
+    std::fprintf(file, "  },\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& result = results[i];
+        std::fprintf(file, "    {\n      \"name\": ");
+        WriteJSONString(file, result.name);
+        std::fprintf(file, ",\n      \"run_type\": \"iteration\",\n");
+        std::fprintf(file, "      \"iterations\": %lld,\n", static_cast<long long>(result.iterations));
+        std::fprintf(file, "      \"real_time\": %.6g,\n", result.secondsPerIteration * 1e9);
+        std::fprintf(file, "      \"cpu_time\": %.6g,\n", result.secondsPerIteration * 1e9);
+        std::fprintf(file, "      \"time_unit\": \"ns\"");
+        if (result.itemsPerSecond > 0.0) std::fprintf(file, ",\n      \"items_per_second\": %.6g", result.itemsPerSecond);
+        if (result.bytesPerSecond > 0.0) std::fprintf(file, ",\n      \"bytes_per_second\": %.6g", result.bytesPerSecond);
+        for (const auto& [counter, value] : result.counters) {
+            std::fprintf(file, ",\n      ");
+            WriteJSONString(file, counter);
+            std::fprintf(file, ": %.6g", value);
+        }
+        if (!result.error.empty()) {
+            std::fprintf(file, ",\n      \"error_occurred\": true,\n      \"error_message\": ");
+            WriteJSONString(file, result.error);
+        }
+        std::fprintf(file, "\n    }%s\n", i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+
+    std::fclose(file);
+    return true;
+}
+
+int RunBenchmarks(int argc, char** argv) {
+    std::string filter;
+    std::string jsonPath;
+    double minTime = 0.5;
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--filter=", 9) == 0) {
+            filter = argv[i] + 9;
+        } else if (std::strncmp(argv[i], "--min_time=", 11) == 0) {
+            minTime = std::atof(argv[i] + 11);
+        } else if (std::strncmp(argv[i], "--json=", 7) == 0) {
+            jsonPath = argv[i] + 7;
+        } else if (std::strncmp(argv[i], "--threads=", 10) == 0) {
+            continue;  // Read by main, the pool is built before
+        } else {
+            std::fprintf(stderr, "Usage: %s [--filter=<substring>] [--min_time=<seconds>] [--json=<file>] [--threads=<workers>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<RunResult> results;
+    std::printf("%-48s %17s %12s\n", "Benchmark", "Time", "Iterations");
+    for (const auto& benchmark : GetRegistry()) {
+        if (!filter.empty() && benchmark->GetName().find(filter) == std::string::npos) continue;
+
+        std::vector<std::vector<int64_t>> runs = benchmark->GetArgs();
+        if (runs.empty()) runs.emplace_back();
+        for (const auto& args : runs) {
+            results.push_back(Run(*benchmark, args, minTime));
+            PrintResult(results.back());
+            std::fflush(stdout);
+        }
+    }
+
+    if (!jsonPath.empty() && !WriteJSON(jsonPath, results)) return 1;
+    const bool failed = std::any_of(results.begin(), results.end(), [](const RunResult& result) { return !result.error.empty(); });
+    return failed ? 1 : 0;
+}
+
+}  // namespace bench
+
+int main(int argc, char** argv) {
+    Logger::Init();
+    EventDispatcher::Init();
+    ThreadPoolProps threadPoolProps;
+    threadPoolProps.nbReservedThreads = 0;  // Nothing renders, the main thread only waits on ParallelFor
+    // Workers split in lanes as in the game, so machines with few cores can still bench the split
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--threads=", 10) == 0) threadPoolProps.nbThreads = std::strtoull(argv[i] + 10, nullptr, 10);
+    }
+    ThreadPool::Init(threadPoolProps);
+
+    int result = bench::RunBenchmarks(argc, argv);
+
+    ThreadPool::Shutdown();
+    EventDispatcher::Shutdown();
+    Logger::Shutdown();
+    return result;
+}
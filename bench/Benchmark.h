@@ -0,0 +1,98 @@
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
+
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bench {
+
+// Timing state handed to a benchmark function, the timed region is the KeepRunning() loop
+class State {
+   public:
+    State(int64_t iterations, const std::vector<int64_t>& args);
+
+    bool KeepRunning();
+    void PauseTiming();
+    void ResumeTiming();
+    // Fails the run, KeepRunning() stops and the runner exits non-zero. For benchmarks that check a budget or a result
+    void SkipWithError(const std::string& message);
+
+    /* Getters */
+    int64_t Range(size_t index) const { return m_Args.at(index); }
+    int64_t GetIterations() const { return m_Iterations; }
+    double GetElapsed() const { return m_Elapsed; }  // Timed seconds so far
+    int64_t GetItemsProcessed() const { return m_ItemsProcessed; }
+    int64_t GetBytesProcessed() const { return m_BytesProcessed; }
+    const std::unordered_map<std::string, double>& GetCounters() const { return m_Counters; }
+    bool HasError() const { return !m_Error.empty(); }
+    const std::string& GetError() const { return m_Error; }
+
+    /* Setters */
+    void SetItemsProcessed(int64_t items) { m_ItemsProcessed = items; }
+    void SetBytesProcessed(int64_t bytes) { m_BytesProcessed = bytes; }
+    void SetCounter(const std::string& name, double value) { m_Counters[name] = value; }
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    int64_t m_Iterations;
+    int64_t m_Remaining;
+    bool m_Started;
+    bool m_Running;
+    Clock::time_point m_Start;
+    double m_Elapsed;
+    int64_t m_ItemsProcessed;
+    int64_t m_BytesProcessed;
+    std::vector<int64_t> m_Args;
+    std::unordered_map<std::string, double> m_Counters;
+    std::string m_Error;
+};
+
+using BenchmarkFunction = void (*)(State&);
+
+class Benchmark {
+   public:
+    Benchmark(const std::string& name, BenchmarkFunction function) : m_Name(name), m_Function(function), m_Iterations(0) {}
+
+    Benchmark* Arg(int64_t arg);
+    Benchmark* Args(std::initializer_list<int64_t> args);
+    Benchmark* Iterations(int64_t iterations);  // Force a fixed iteration count instead of the time based one
+
+    /* Getters */
+    const std::string& GetName() const { return m_Name; }
+    BenchmarkFunction GetFunction() const { return m_Function; }
+    const std::vector<std::vector<int64_t>>& GetArgs() const { return m_Args; }
+    int64_t GetFixedIterations() const { return m_Iterations; }
+
+   private:
+    std::string m_Name;
+    BenchmarkFunction m_Function;
+    std::vector<std::vector<int64_t>> m_Args;
+    int64_t m_Iterations;
+};
+
+Benchmark* RegisterBenchmark(const std::string& name, BenchmarkFunction function);
+int RunBenchmarks(int argc, char** argv);
+
+// Prevent the compiler from optimizing away a computed value
+template <class T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* s_Sink;
+    s_Sink = &value;
+#endif
+}
+
+}  // namespace bench
+
+#define BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_IMPL(a, b)
+#define BENCHMARK(fn) static bench::Benchmark* BENCHMARK_CONCAT(s_Benchmark, __LINE__) = bench::RegisterBenchmark(#fn, fn)
+
+#endif  // __BENCHMARK_H__
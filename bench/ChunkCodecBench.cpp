@@ -0,0 +1,67 @@
+#include <vector>
+
+#include "Benchmark.h"
+#include "app/Chunk.h"
+#include "app/ChunkCodec.h"
+#include "app/Noise.h"
+#include "app/RegionCache.h"
+
+constexpr int NB_CODEC_CHUNKS_SIDE = 8;  // One region of generated terrain
+
+// Blocks of the chunks of the region at the origin, as the game generates them
+static const std::vector<BlockArray>& GetTerrainBlocks() {
+    static const std::vector<BlockArray> s_Blocks = []() {
+        RegionCache regions{Noise()};
+        const auto region = regions.GetRegion(0, 0);
+
+        std::vector<BlockArray> blocks(NB_CODEC_CHUNKS_SIDE * NB_CODEC_CHUNKS_SIDE);
+        for (int z = 0; z < NB_CODEC_CHUNKS_SIDE; z++) {
+            for (int x = 0; x < NB_CODEC_CHUNKS_SIDE; x++) {
+                Chunk chunk(glm::ivec3(x * CHUNK_WIDTH, 0, z * CHUNK_WIDTH));
+                chunk.GenerateData(*region);
+                chunk.GetBlocks(blocks[z * NB_CODEC_CHUNKS_SIDE + x]);
+                chunk.Unload();
+            }
+        }
+        return blocks;
+    }();
+    return s_Blocks;
+}
+
+static void BM_ChunkCodec_Encode(bench::State& state) {
+    const auto& chunks = GetTerrainBlocks();
+    std::vector<uint8_t> payload;
+    size_t nbEncodedBytes = 0;
+
+    while (state.KeepRunning()) {
+        nbEncodedBytes = 0;
+        for (const BlockArray& blocks : chunks) {
+            payload.clear();
+            ChunkCodec::Encode(blocks, payload);
+            nbEncodedBytes += payload.size();
+        }
+        bench::DoNotOptimize(payload.data());
+    }
+
+    // Throughput in uncompressed bytes, one byte per voxel
+    state.SetItemsProcessed(state.GetIterations() * chunks.size());
+    state.SetBytesProcessed(state.GetIterations() * chunks.size() * NB_VOXELS_IN_CHUNK);
+    state.SetCounter("ratio", static_cast<double>(chunks.size() * NB_VOXELS_IN_CHUNK) / nbEncodedBytes);
+}
+BENCHMARK(BM_ChunkCodec_Encode);
+
+static void BM_ChunkCodec_Decode(bench::State& state) {
+    const auto& chunks = GetTerrainBlocks();
+    std::vector<std::vector<uint8_t>> payloads(chunks.size());
+    for (size_t i = 0; i < chunks.size(); i++) ChunkCodec::Encode(chunks[i], payloads[i]);
+
+    BlockArray blocks;
+    while (state.KeepRunning()) {
+        for (const auto& payload : payloads) ChunkCodec::Decode(payload.data(), payload.size(), blocks);
+        bench::DoNotOptimize(blocks.data());
+    }
+
+    state.SetItemsProcessed(state.GetIterations() * chunks.size());
+    state.SetBytesProcessed(state.GetIterations() * chunks.size() * NB_VOXELS_IN_CHUNK);
+}
+BENCHMARK(BM_ChunkCodec_Decode);
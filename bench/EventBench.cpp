@@ -0,0 +1,22 @@
+#include "Benchmark.h"
+#include "events/EventApplication.h"
+#include "events/EventDispatcher.h"
+
+// One dispatch to N listeners of the event's category, plus as many listeners of another category it has to skip
+static void BM_EventDispatcher_Dispatch(bench::State& state) {
+    auto dispatcher = EventDispatcher::Create();
+    int64_t nbCalls = 0;
+    for (int64_t i = 0; i < state.Range(0); i++) {
+        dispatcher->Subscribe(EventCategory::EventCategoryApplication, [&nbCalls](const Event&) { nbCalls++; });
+        dispatcher->Subscribe(EventCategory::EventCategoryMouse, [&nbCalls](const Event&) { nbCalls++; });
+    }
+
+    ChunkDataGeneratedEvent event;
+    while (state.KeepRunning()) {
+        dispatcher->Dispatch(event);
+    }
+
+    bench::DoNotOptimize(nbCalls);
+    state.SetItemsProcessed(state.GetIterations() * state.Range(0));
+}
+BENCHMARK(BM_EventDispatcher_Dispatch)->Arg(1)->Arg(16)->Arg(256)->Arg(1024);
@@ -0,0 +1,95 @@
+#include <vector>
+
+#include "Benchmark.h"
+#include "app/Chunk.h"
+#include "app/LightEngine.h"
+#include "app/Noise.h"
+#include "app/RegionCache.h"
+
+constexpr int LIGHT_BENCH_SIDE = 5;  // Chunks per side, the 3x3 area around the center chunk is all lit
+constexpr uint8_t TORCH_LEVEL = LIGHT_MAX;
+
+// Generated terrain chunks, lit one by one as the mesh jobs do
+struct LitTerrain {
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    LightEngine engine;
+
+    LitTerrain() {
+        RegionCache regions{Noise()};
+        for (int z = 0; z < LIGHT_BENCH_SIDE; z++) {
+            for (int x = 0; x < LIGHT_BENCH_SIDE; x++) {
+                auto chunk = std::make_shared<Chunk>(glm::ivec3(x * CHUNK_WIDTH, 0, z * CHUNK_WIDTH));
+                chunk->GenerateData(*regions.GetRegion(x * CHUNK_WIDTH, z * CHUNK_WIDTH));
+                chunks.push_back(chunk);
+            }
+        }
+        for (int z = 0; z < LIGHT_BENCH_SIDE; z++) {
+            for (int x = 0; x < LIGHT_BENCH_SIDE; x++) engine.LightChunk(GetArea(x, z));
+        }
+        std::vector<std::weak_ptr<Chunk>> dirty;
+        engine.TakeDirtyChunks(dirty);
+    }
+    ~LitTerrain() {
+        for (auto& chunk : chunks) chunk->Unload();
+    }
+
+    ChunkArea GetArea(int chunkX, int chunkZ) const {
+        ChunkArea area;
+        for (int dz = -1; dz <= 1; dz++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                const int x = chunkX + dx, z = chunkZ + dz;
+                const bool inside = x >= 0 && x < LIGHT_BENCH_SIDE && z >= 0 && z < LIGHT_BENCH_SIDE;
+                area[(dz + 1) * LIGHT_AREA_SIZE + dx + 1] = inside ? chunks[z * LIGHT_BENCH_SIDE + x] : nullptr;
+            }
+        }
+        return area;
+    }
+
+    // First air voxel above the ground of a world column
+    glm::ivec3 GetSurface(int worldX, int worldZ) const {
+        const Chunk& chunk = *chunks[(worldZ / CHUNK_WIDTH) * LIGHT_BENCH_SIDE + worldX / CHUNK_WIDTH];
+        int y = 0;
+        while (y < CHUNK_HEIGHT - 1 && chunk.IsOpaque(Chunk::ToVoxelIndex(worldX % CHUNK_WIDTH, y, worldZ % CHUNK_WIDTH))) y++;
+        return glm::ivec3(worldX, y, worldZ);
+    }
+
+    std::vector<uint8_t> Snapshot() const {
+        std::vector<uint8_t> light;
+        light.reserve(chunks.size() * NB_VOXELS_IN_CHUNK);
+        for (const auto& chunk : chunks) {
+            for (int index = 0; index < NB_VOXELS_IN_CHUNK; index++) light.push_back(chunk->GetLight(index));
+        }
+        return light;
+    }
+};
+
+// Lighting of one chunk in its mesh job: sunlight alone, then joined to its 8 lit neighbors
+static void BM_Light_Chunk(bench::State& state) {
+    LitTerrain terrain;
+    const ChunkArea area = terrain.GetArea(LIGHT_BENCH_SIDE / 2, LIGHT_BENCH_SIDE / 2);
+
+    while (state.KeepRunning()) {
+        terrain.engine.LightChunk(area);
+    }
+
+    state.SetItemsProcessed(state.GetIterations() * NB_VOXELS_IN_CHUNK);
+}
+BENCHMARK(BM_Light_Chunk);
+
+// A torch placed on the ground then removed, one incremental update each. Arg 0 places it in the middle of the center
+// chunk, arg 1 in its corner so the light spreads into three neighbors
+static void BM_Light_Torch(bench::State& state) {
+    LitTerrain terrain;
+    const int center = LIGHT_BENCH_SIDE / 2;
+    const ChunkArea area = terrain.GetArea(center, center);
+    const int offset = state.Range(0) == 0 ? CHUNK_WIDTH / 2 : 0;
+    const glm::ivec3 torch = terrain.GetSurface(center * CHUNK_WIDTH + offset, center * CHUNK_WIDTH + offset);
+
+    while (state.KeepRunning()) {
+        terrain.engine.SetSource(area, torch, TORCH_LEVEL);
+        terrain.engine.SetSource(area, torch, 0);
+    }
+
+    state.SetItemsProcessed(state.GetIterations() * 2);  // Updates
+}
+BENCHMARK(BM_Light_Torch)->Args({0})->Args({1});
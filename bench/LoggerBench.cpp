@@ -0,0 +1,57 @@
+#include <string>
+
+#include "Benchmark.h"
+#include "utils/Logger.h"
+
+constexpr int64_t NB_LOG_SITES_PER_ITERATION = 64;
+
+// Stands for an expensive log argument, counts how many times it is evaluated
+static int64_t s_NbArgumentEvaluations = 0;
+static std::string ExpensiveArgument() {
+    s_NbArgumentEvaluations++;
+    return std::string(64, 'x');
+}
+
+// Loop body without any log site, the reference for the disabled site below
+static void BM_Log_Baseline(bench::State& state) {
+    int64_t sum = 0;
+    while (state.KeepRunning()) {
+        for (int64_t i = 0; i < NB_LOG_SITES_PER_ITERATION; i++) {
+            sum += i;
+            bench::DoNotOptimize(sum);
+        }
+    }
+    state.SetItemsProcessed(state.GetIterations() * NB_LOG_SITES_PER_ITERATION);
+}
+BENCHMARK(BM_Log_Baseline);
+
+// Same loop with a trace site compiled out: same time as the baseline and no argument evaluated
+static void BM_Log_DisabledSite(bench::State& state) {
+    s_NbArgumentEvaluations = 0;
+    int64_t sum = 0;
+    while (state.KeepRunning()) {
+        for (int64_t i = 0; i < NB_LOG_SITES_PER_ITERATION; i++) {
+            sum += i;
+            bench::DoNotOptimize(sum);
+            LOG_TRACE("Disabled site {0} {1}", i, ExpensiveArgument());
+        }
+    }
+    state.SetItemsProcessed(state.GetIterations() * NB_LOG_SITES_PER_ITERATION);
+    state.SetCounter("trace_compiled_in", LogLevel::Trace >= LOG_MIN_LEVEL ? 1.0 : 0.0);
+    state.SetCounter("args_evaluated", static_cast<double>(s_NbArgumentEvaluations));
+}
+BENCHMARK(BM_Log_DisabledSite);
+
+// An enabled site past its rate limit, the cost a hot path miss warning has on a worker
+static void BM_Log_RateLimitedSite(bench::State& state) {
+    int64_t sum = 0;
+    while (state.KeepRunning()) {
+        for (int64_t i = 0; i < NB_LOG_SITES_PER_ITERATION; i++) {
+            sum += i;
+            bench::DoNotOptimize(sum);
+            LOG_WARNING("Rate limited site {0}", i);
+        }
+    }
+    state.SetItemsProcessed(state.GetIterations() * NB_LOG_SITES_PER_ITERATION);
+}
+BENCHMARK(BM_Log_RateLimitedSite);
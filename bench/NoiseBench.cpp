@@ -0,0 +1,50 @@
+#include <vector>
+
+#include "Benchmark.h"
+#include "app/Noise.h"
+
+// One FastNoiseLite::GetNoise call per column, the way chunks sampled their heightmap before batching
+static void BM_Noise_PerSample(bench::State& state) {
+    const int size = static_cast<int>(state.Range(0));
+    Noise noise;
+    std::vector<float> heights(size * size);
+
+    while (state.KeepRunning()) {
+        for (int z = 0; z < size; z++) {
+            for (int x = 0; x < size; x++) heights[z * size + x] = noise.GetNoise(static_cast<float>(x), static_cast<float>(z));
+        }
+        bench::DoNotOptimize(heights.data());
+    }
+
+    state.SetItemsProcessed(state.GetIterations() * size * size);
+}
+BENCHMARK(BM_Noise_PerSample)->Arg(16)->Arg(128);
+
+// Whole tile through one batch kernel, Range(1) is the Noise::Backend
+static void BM_Noise_Tile(bench::State& state) {
+    const int size = static_cast<int>(state.Range(0));
+    const auto backend = static_cast<Noise::Backend>(state.Range(1));
+    Noise noise;
+    std::vector<float> heights(size * size);
+
+    // Kernels this CPU lacks are reported as such rather than silently measured on a fallback
+    if (backend > Noise::GetBestBackend()) {
+        state.SetCounter("unsupported", 1.0);
+        return;
+    }
+    noise.SetBackend(backend);
+
+    while (state.KeepRunning()) {
+        noise.GenerateTile(0, 0, size, size, heights.data());
+        bench::DoNotOptimize(heights.data());
+    }
+
+    state.SetItemsProcessed(state.GetIterations() * size * size);
+}
+BENCHMARK(BM_Noise_Tile)
+    ->Args({16, static_cast<int64_t>(Noise::Backend::Scalar)})
+    ->Args({16, static_cast<int64_t>(Noise::Backend::SSE41)})
+    ->Args({16, static_cast<int64_t>(Noise::Backend::AVX2)})
+    ->Args({128, static_cast<int64_t>(Noise::Backend::Scalar)})
+    ->Args({128, static_cast<int64_t>(Noise::Backend::SSE41)})
+    ->Args({128, static_cast<int64_t>(Noise::Backend::AVX2)});
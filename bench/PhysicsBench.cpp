@@ -0,0 +1,120 @@
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+
+#include "Benchmark.h"
+#include "app/CollisionManager.h"
+#include "app/EntityBroadphase.h"
+#include "app/Entity.h"
+#include "app/EntityStore.h"
+#include "app/PhysicsSystem.h"
+#include "app/Voxel.h"
+#include "app/VoxelGrid.h"
+#include "core/ThreadPool.h"
+
+constexpr int GROUND_HEIGHT = 8;
+constexpr float SPAWN_AREA = 256.0f;
+
+// Infinite flat ground, solid below GROUND_HEIGHT
+class FlatGround : public VoxelGrid {
+   public:
+    FlatGround() : m_Solid(glm::vec3(0.0f)) {}
+
+    Voxel* GetVoxel(const glm::vec3& pos) const override { return pos.y < GROUND_HEIGHT ? &m_Solid : nullptr; }
+
+   private:
+    mutable Voxel m_Solid;
+};
+
+static void SpawnMobs(EntityStore& store, size_t count) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> horizontal(0.0f, SPAWN_AREA);
+    std::uniform_real_distribution<float> height(GROUND_HEIGHT, GROUND_HEIGHT + 16.0f);
+    std::uniform_real_distribution<float> speed(-4.0f, 4.0f);
+
+    store.Reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        glm::vec3 position(horizontal(rng), height(rng), horizontal(rng));
+        EntityID id = store.Create(glm::vec3(.6f, 1.8f, .6f), glm::vec3(.3f, 0.0f, .3f), position, GRAVITY);
+        store.GetVelocities()[store.GetIndex(id)] = glm::vec3(speed(rng), 0.0f, speed(rng));
+    }
+}
+
+// Chunk jobs kept queued on both lanes, as while the world streams in
+class ChunkJobLoad {
+   public:
+    ~ChunkJobLoad() {
+        while (m_NbQueued.load() > 0) std::this_thread::yield();
+    }
+
+    void TopUp() {
+        for (JobLane lane : {JobLane::Generation, JobLane::Meshing}) {
+            for (int i = m_NbQueued.load(); i < NB_QUEUED_CHUNK_JOBS; i++) {
+                m_NbQueued++;
+                ThreadPool::Get().Enqueue(lane, [this]() {
+                    const auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(CHUNK_JOB_MICROSECONDS);
+                    while (std::chrono::steady_clock::now() < end) {}
+                    m_NbQueued--;
+                });
+            }
+        }
+    }
+
+   private:
+    static constexpr int NB_QUEUED_CHUNK_JOBS = 16;
+    static constexpr int CHUNK_JOB_MICROSECONDS = 500;
+
+    std::atomic<int> m_NbQueued = 0;
+};
+
+// One fixed physics step for N mobs walking on flat ground, budget_% is the share of a 120 Hz tick it takes.
+// Arg 1 = 1 keeps chunk jobs queued on both lanes meanwhile. Run with --threads= to split the pool on small machines
+static void BM_PhysicsSystem_Step(bench::State& state) {
+    FlatGround ground;
+    EntityStore store;
+    CollisionManager collisionManager(ground);
+    PhysicsSystem physics(store, collisionManager);
+    SpawnMobs(store, static_cast<size_t>(state.Range(0)));
+    ChunkJobLoad chunkJobs;
+
+    while (state.KeepRunning()) {
+        if (state.Range(1) != 0) {
+            state.PauseTiming();
+            chunkJobs.TopUp();
+            state.ResumeTiming();
+        }
+        physics.Update(PHYSICS_STEP);
+    }
+
+    state.SetItemsProcessed(state.GetIterations() * state.Range(0));
+    state.SetCounter("budget_%", state.GetElapsed() / state.GetIterations() / PHYSICS_STEP * 100.0);
+    state.SetCounter("workers", static_cast<double>(ThreadPool::Get().GetNbThreads()));
+}
+BENCHMARK(BM_PhysicsSystem_Step)->Args({1000, 0})->Args({10000, 0})->Args({10000, 1});
+
+// Broadphase update and pair generation alone, pairs_tested is what the narrowphase sees against the naive n²/2
+static void BM_EntityBroadphase_Pairs(bench::State& state) {
+    EntityStore store;
+    EntityBroadphase broadphase;
+    std::vector<EntityPair> pairs;
+    SpawnMobs(store, static_cast<size_t>(state.Range(0)));
+
+    while (state.KeepRunning()) {
+        broadphase.Update(store);
+        broadphase.FindPairs(pairs);
+        bench::DoNotOptimize(pairs.data());
+    }
+
+    size_t nbOverlaps = 0;
+    for (const auto& [a, b] : pairs) {
+        if (store.GetBoxes()[store.GetIndex(a)].Intersects(store.GetBoxes()[store.GetIndex(b)])) nbOverlaps++;
+    }
+
+    double nbEntities = static_cast<double>(state.Range(0));
+    state.SetItemsProcessed(state.GetIterations() * state.Range(0));
+    state.SetCounter("pairs_tested", static_cast<double>(pairs.size()));
+    state.SetCounter("naive_pairs", nbEntities * (nbEntities - 1.0) / 2.0);
+    state.SetCounter("overlaps", static_cast<double>(nbOverlaps));
+}
+BENCHMARK(BM_EntityBroadphase_Pairs)->Arg(100)->Arg(1000)->Arg(10000);
@@ -0,0 +1,176 @@
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "Benchmark.h"
+#include "core/ThreadPool.h"
+
+constexpr int64_t NB_TASKS_PER_ITERATION = 256;
+constexpr size_t NB_BENCH_WORKERS = 4;
+
+// The pool as it was before Job: every task copied into a [=] lambda, then into a std::function
+class FunctionThreadPool {
+   public:
+    FunctionThreadPool(size_t numThreads) : m_Stop(false) {
+        for (size_t i = 0; i < numThreads; ++i) {
+            m_Workers.emplace_back([this] {
+                while (true) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(m_QueueMutex);
+                        m_Condition.wait(lock, [this] { return m_Stop || !m_Tasks.empty(); });
+                        if (m_Stop && m_Tasks.empty()) return;
+                        task = std::move(m_Tasks.front());
+                        m_Tasks.pop();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+    ~FunctionThreadPool() {
+        {
+            std::unique_lock<std::mutex> lock(m_QueueMutex);
+            m_Stop = true;
+        }
+        m_Condition.notify_all();
+        for (std::thread& worker : m_Workers) worker.join();
+    }
+
+    template <class F, class... Args>
+    void Enqueue(F&& f, Args&&... args) {
+        {
+            std::unique_lock<std::mutex> lock(m_QueueMutex);
+            m_Tasks.emplace([=] { f(args...); });
+        }
+        m_Condition.notify_one();
+    }
+
+   private:
+    std::vector<std::thread> m_Workers;
+    std::queue<std::function<void()>> m_Tasks;
+    std::mutex m_QueueMutex;
+    std::condition_variable m_Condition;
+    bool m_Stop;
+};
+
+// Task captures of Size bytes, the completion counter included. A chunk job captures 32: two shared_ptr
+template <size_t Size>
+struct Capture {
+    std::atomic<int64_t>* done;
+    std::array<unsigned char, Size - sizeof(std::atomic<int64_t>*)> data;
+};
+
+template <size_t Size, class Pool>
+static void RunTasks(bench::State& state, Pool& pool) {
+    std::atomic<int64_t> done = 0;
+    Capture<Size> capture = {&done, {}};
+    int64_t expected = 0;
+
+    while (state.KeepRunning()) {
+        for (int64_t i = 0; i < NB_TASKS_PER_ITERATION; i++) {
+            pool.Enqueue([capture] {
+                bench::DoNotOptimize(capture.data);
+                capture.done->fetch_add(1, std::memory_order_release);
+            });
+        }
+        expected += NB_TASKS_PER_ITERATION;
+        while (done.load(std::memory_order_acquire) < expected) std::this_thread::yield();
+    }
+
+    state.SetItemsProcessed(state.GetIterations() * NB_TASKS_PER_ITERATION);
+    state.SetCounter("inline", Job::FITS_INLINE<Capture<Size>> ? 1.0 : 0.0);
+}
+
+// Enqueue + execute cost per task, Range(0) is the capture size in bytes, Range(1) the pool: 0 std::function, 1 Job
+static void BM_ThreadPool_Enqueue(bench::State& state) {
+    const int64_t captureSize = state.Range(0);
+    auto run = [&](auto& pool) {
+        switch (captureSize) {
+            case 16:
+                RunTasks<16>(state, pool);
+                break;
+            case 32:
+                RunTasks<32>(state, pool);
+                break;
+            case 48:
+                RunTasks<48>(state, pool);
+                break;
+            default:
+                RunTasks<256>(state, pool);
+                break;
+        }
+    };
+
+    if (state.Range(1) == 0) {
+        FunctionThreadPool pool(NB_BENCH_WORKERS);
+        run(pool);
+    } else {
+        ThreadPool pool(NB_BENCH_WORKERS);
+        run(pool);
+    }
+}
+BENCHMARK(BM_ThreadPool_Enqueue)->Args({16, 0})->Args({16, 1})->Args({32, 0})->Args({32, 1})->Args({48, 0})->Args({48, 1})->Args({256, 0})->Args({256, 1});
+
+// The same task path on one thread, without the workers' wake ups: wrap, push, pop and run.
+// Range(0) is the capture size in bytes, Range(1) the task type: 0 std::function, 1 Job
+template <size_t Size, class Task>
+static void RunTaskPath(bench::State& state) {
+    std::atomic<int64_t> done = 0;
+    Capture<Size> capture = {&done, {}};
+    std::queue<Task> tasks;
+
+    while (state.KeepRunning()) {
+        for (int64_t i = 0; i < NB_TASKS_PER_ITERATION; i++) {
+            auto f = [capture] {
+                bench::DoNotOptimize(capture.data);
+                capture.done->fetch_add(1, std::memory_order_relaxed);
+            };
+            if constexpr (std::is_same_v<Task, Job>) {
+                tasks.emplace(std::move(f));
+            } else {
+                tasks.emplace([=] { f(); });  // The old Enqueue wrapper
+            }
+        }
+        while (!tasks.empty()) {
+            Task task = std::move(tasks.front());
+            tasks.pop();
+            task();
+        }
+    }
+
+    state.SetItemsProcessed(state.GetIterations() * NB_TASKS_PER_ITERATION);
+}
+
+static void BM_ThreadPool_TaskPath(bench::State& state) {
+    const int64_t captureSize = state.Range(0);
+    auto run = [&]<class Task>() {
+        switch (captureSize) {
+            case 16:
+                RunTaskPath<16, Task>(state);
+                break;
+            case 32:
+                RunTaskPath<32, Task>(state);
+                break;
+            case 48:
+                RunTaskPath<48, Task>(state);
+                break;
+            default:
+                RunTaskPath<256, Task>(state);
+                break;
+        }
+    };
+
+    if (state.Range(1) == 0) {
+        run.template operator()<std::function<void()>>();
+    } else {
+        run.template operator()<Job>();
+    }
+}
+BENCHMARK(BM_ThreadPool_TaskPath)->Args({16, 0})->Args({16, 1})->Args({32, 0})->Args({32, 1})->Args({48, 0})->Args({48, 1})->Args({256, 0})->Args({256, 1});
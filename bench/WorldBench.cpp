@@ -0,0 +1,382 @@
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <thread>
+
+#include "Benchmark.h"
+#include "app/Chunk.h"
+#include "app/CollisionManager.h"
+#include "app/Entity.h"
+#include "app/EntityStore.h"
+#include "app/FarTerrain.h"
+#include "app/LodTile.h"
+#include "app/Noise.h"
+#include "app/RegionCache.h"
+#include "app/World.h"
+#include "core/ThreadPool.h"
+
+// Chunk whose committed meshes are taken like the renderer does, so they do not pile up between iterations
+class BenchChunk : public Chunk {
+   public:
+    BenchChunk(const glm::ivec3& position) : Chunk(position) {}
+
+    // Swaps the last committed mesh in and frees it as after an upload. Returns its number of vertices, 0 without one
+    size_t TakeMesh() {
+        if (!SwapMesh()) return 0;
+        const size_t nbVertices = GetVertices().size() / CHUNK_VERTEX_SIZE;
+        ReleaseCPUMesh();
+        return nbVertices;
+    }
+};
+
+// Center chunk at the origin with its four neighbors, all generated with the game's noise settings
+struct ChunkNeighborhood {
+    std::shared_ptr<BenchChunk> center;
+    std::array<std::shared_ptr<Chunk>, 4> neighbors;
+
+    ChunkNeighborhood() {
+        RegionCache regions{Noise()};
+        center = std::make_shared<BenchChunk>(glm::ivec3(0));
+        neighbors[X_POS] = std::make_shared<Chunk>(glm::ivec3(CHUNK_WIDTH, 0, 0));
+        neighbors[X_NEG] = std::make_shared<Chunk>(glm::ivec3(-CHUNK_WIDTH, 0, 0));
+        neighbors[Z_POS] = std::make_shared<Chunk>(glm::ivec3(0, 0, CHUNK_WIDTH));
+        neighbors[Z_NEG] = std::make_shared<Chunk>(glm::ivec3(0, 0, -CHUNK_WIDTH));
+
+        center->GenerateData(*regions.GetRegion(0, 0));
+        for (auto& neighbor : neighbors) {
+            const glm::vec3& position = neighbor->GetPosition();
+            neighbor->GenerateData(*regions.GetRegion(static_cast<int>(position.x), static_cast<int>(position.z)));
+        }
+    }
+    ~ChunkNeighborhood() {
+        center->Unload();
+        for (auto& neighbor : neighbors) neighbor->Unload();
+    }
+};
+
+// Fill a chunk with voxels from a cached region heightmap, allocation included
+static void BM_Chunk_GenerateData(bench::State& state) {
+    RegionCache regions{Noise()};
+    const auto region = regions.GetRegion(0, 0);
+    Chunk chunk(glm::ivec3(0));
+
+    while (state.KeepRunning()) {
+        chunk.GenerateData(*region);
+
+        state.PauseTiming();
+        chunk.Unload();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.GetIterations() * NB_VOXELS_IN_CHUNK);
+}
+BENCHMARK(BM_Chunk_GenerateData);
+
+// Height and climate maps of one region, what its REGION_SIZE x REGION_SIZE chunks used to sample one by one
+static void BM_Region_Generate(bench::State& state) {
+    int regionX = 0;
+
+    while (state.KeepRunning()) {
+        RegionCache regions(Noise(), 1);
+        bench::DoNotOptimize(regions.GetRegion(regionX, 0));
+        regionX += REGION_WIDTH;
+    }
+
+    state.SetItemsProcessed(state.GetIterations() * REGION_SIZE * REGION_SIZE);  // Chunks served
+    state.SetCounter("columns", NB_COLUMNS_IN_REGION);
+}
+BENCHMARK(BM_Region_Generate);
+
+// World generation throughput of a pool of Range(0) generation workers, the streaming job without the save: chunks
+// of areas never generated before, so the workers also share the region heightmaps like when walking
+constexpr int SCALING_AREA_SIZE = 2 * REGION_SIZE;  // Chunks per side of the area generated each iteration
+
+static void BM_World_GenerationScaling(bench::State& state) {
+    ThreadPool pool(static_cast<size_t>(state.Range(0)));
+    RegionCache regions{Noise()};
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    int areaX = 0;
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        chunks.clear();
+        for (int z = 0; z < SCALING_AREA_SIZE; z++) {
+            for (int x = 0; x < SCALING_AREA_SIZE; x++) {
+                chunks.push_back(std::make_unique<Chunk>(glm::ivec3((areaX + x) * CHUNK_WIDTH, 0, z * CHUNK_WIDTH)));
+            }
+        }
+        areaX += SCALING_AREA_SIZE;
+        state.ResumeTiming();
+
+        JobCounter counter;
+        for (auto& chunk : chunks) {
+            pool.Enqueue(counter, [&regions, chunkPtr = chunk.get()]() {
+                const glm::vec3& position = chunkPtr->GetPosition();
+                chunkPtr->GenerateData(*regions.GetRegion(static_cast<int>(position.x), static_cast<int>(position.z)));
+            });
+        }
+        counter.Wait();
+    }
+    state.PauseTiming();
+    chunks.clear();
+    state.ResumeTiming();
+
+    state.SetItemsProcessed(state.GetIterations() * SCALING_AREA_SIZE * SCALING_AREA_SIZE);  // Chunks
+    state.SetCounter("threads", static_cast<double>(state.Range(0)));
+    state.SetCounter("cores", static_cast<double>(ThreadPool::GetNbCores()));
+}
+
+// 1 to N workers, N the number of cores, doubling in between
+static bench::Benchmark* s_GenerationScaling = [] {
+    bench::Benchmark* benchmark = bench::RegisterBenchmark("BM_World_GenerationScaling", BM_World_GenerationScaling);
+    const size_t nbCores = ThreadPool::GetNbCores();
+    for (size_t nbThreads = 1; nbThreads < nbCores; nbThreads *= 2) benchmark->Arg(static_cast<int64_t>(nbThreads));
+    return benchmark->Arg(static_cast<int64_t>(nbCores));
+}();
+
+static void BM_Chunk_RemoveInternalFaces(bench::State& state) {
+    ChunkNeighborhood chunks;
+
+    while (state.KeepRunning()) {
+        chunks.center->RemoveInternalFaces();
+    }
+
+    state.SetItemsProcessed(state.GetIterations() * NB_VOXELS_IN_CHUNK);
+}
+BENCHMARK(BM_Chunk_RemoveInternalFaces);
+
+static void BM_Chunk_RemoveBoundaryFaces(bench::State& state) {
+    ChunkNeighborhood chunks;
+    chunks.center->RemoveInternalFaces();
+
+    while (state.KeepRunning()) {
+        chunks.center->RemoveBoundaryFaces(chunks.neighbors);
+    }
+
+    state.SetItemsProcessed(state.GetIterations() * NB_BOUNDARY_VOXELS_IN_CHUNK);
+}
+BENCHMARK(BM_Chunk_RemoveBoundaryFaces);
+
+// Mesh of a culled chunk, as the mesh task builds it
+static void BM_Chunk_GenerateMesh(bench::State& state) {
+    ChunkNeighborhood chunks;
+    chunks.center->RemoveInternalFaces();
+    chunks.center->RemoveBoundaryFaces(chunks.neighbors);
+
+    size_t nbVertices = 0;
+    size_t nbTriangles = 0;
+    while (state.KeepRunning()) {
+        chunks.center->GenerateMesh(chunks.neighbors);
+
+        state.PauseTiming();
+        nbTriangles = chunks.center->GetNbTriangles();
+        nbVertices = chunks.center->TakeMesh();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.GetIterations() * NB_VOXELS_IN_CHUNK);
+    state.SetCounter("vertices", static_cast<double>(nbVertices));
+    state.SetCounter("triangles", static_cast<double>(nbTriangles));
+}
+BENCHMARK(BM_Chunk_GenerateMesh);
+
+// A drawn chunk remeshed without pause by a worker, as continuous relighting does, while the main thread swaps the
+// committed meshes in once per frame. Meshes committed between two frames replace each other, only the last is drawn
+static void BM_Chunk_RemeshWhileDrawn(bench::State& state) {
+    ChunkNeighborhood chunks;
+    chunks.center->RemoveInternalFaces();
+    chunks.center->RemoveBoundaryFaces(chunks.neighbors);
+
+    std::atomic<bool> running = true;
+    std::atomic<size_t> nbCommits = 0;
+    std::thread worker([&]() {
+        while (running.load(std::memory_order_relaxed)) {
+            chunks.center->GenerateMesh(chunks.neighbors);
+            nbCommits.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    size_t nbSwaps = 0;
+    while (state.KeepRunning()) {
+        nbSwaps += chunks.center->TakeMesh() > 0;
+        std::this_thread::sleep_for(std::chrono::microseconds(500));  // Rest of the frame
+    }
+    running = false;
+    worker.join();
+    chunks.center->TakeMesh();
+
+    state.SetItemsProcessed(state.GetIterations());  // Frames
+    state.SetCounter("commits_per_frame", static_cast<double>(nbCommits) / static_cast<double>(state.GetIterations()));
+    state.SetCounter("swaps_per_frame", static_cast<double>(nbSwaps) / static_cast<double>(state.GetIterations()));
+}
+BENCHMARK(BM_Chunk_RemeshWhileDrawn)->Iterations(2000);
+
+// Ambient occlusion cost in the mesher: the same chunk meshed without then with it, alternating so both see the same
+// machine state, best time of each. Fails when the overhead goes past the 20% meshing budget
+constexpr double OCCLUSION_MESH_BUDGET = 1.2;
+
+static void BM_Chunk_OcclusionOverhead(bench::State& state) {
+    using Clock = std::chrono::steady_clock;
+    ChunkNeighborhood chunks;
+    chunks.center->RemoveInternalFaces();
+    chunks.center->RemoveBoundaryFaces(chunks.neighbors);
+
+    auto timeMesh = [&chunks](bool ambientOcclusion) {
+        Chunk::SetAmbientOcclusion(ambientOcclusion);
+        const auto start = Clock::now();
+        chunks.center->GenerateMesh(chunks.neighbors);
+        const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        chunks.center->TakeMesh();
+        return elapsed;
+    };
+
+    double bestWithout = std::numeric_limits<double>::max();
+    double bestWith = std::numeric_limits<double>::max();
+    while (state.KeepRunning()) {
+        bestWithout = std::min(bestWithout, timeMesh(false));
+        bestWith = std::min(bestWith, timeMesh(true));
+    }
+    Chunk::SetAmbientOcclusion(true);
+
+    const double overhead = bestWith / bestWithout;
+    state.SetItemsProcessed(state.GetIterations() * 2);  // Meshes
+    state.SetCounter("without_us", bestWithout * 1e6);
+    state.SetCounter("with_us", bestWith * 1e6);
+    state.SetCounter("overhead", overhead);
+    if (overhead > OCCLUSION_MESH_BUDGET) {
+        state.SkipWithError("ambient occlusion costs " + std::to_string(static_cast<int>((overhead - 1.0) * 100.0)) + "% meshing time, over the 20% budget");
+    }
+}
+BENCHMARK(BM_Chunk_OcclusionOverhead)->Iterations(200);  // Fixed, every run is checked against the budget
+
+// One LOD tile per level, 2x2, 4x4 and 8x8 chunks generated, downsampled and meshed. The triangles stay about those of
+// one full chunk whatever the level
+static void BM_LodTile_Generate(bench::State& state) {
+    RegionCache regions{Noise()};
+    const int level = static_cast<int>(state.Range(0));
+    LodTile tile(glm::ivec2(0), level);
+
+    while (state.KeepRunning()) {
+        tile.Generate(regions, nullptr);
+    }
+
+    state.SetItemsProcessed(state.GetIterations() * tile.GetSize() * tile.GetSize());  // Chunks
+    state.SetCounter("triangles", static_cast<double>(tile.GetNbTriangles()));
+}
+BENCHMARK(BM_LodTile_Generate)->Arg(1)->Arg(2)->Arg(3);
+
+// Far terrain following a camera walking one chunk per iteration, as ChunkManager::SetCenter drives it. Only the
+// uncovered rows of heights are sampled, a level is remeshed when it or the square inside it moved
+static void BM_FarTerrain_Recenter(bench::State& state) {
+    const Noise noise;
+    FarTerrain terrain;
+    const int inner = 64 * CHUNK_WIDTH;  // The voxel terrain at the default far distance
+    terrain.SetCenter(noise, glm::ivec2(0), glm::ivec2(-inner), glm::ivec2(inner));
+    const size_t initialSamples = terrain.GetNbSamples();
+
+    int x = 0;
+    while (state.KeepRunning()) {
+        x += CHUNK_WIDTH;
+        const int innerX = (x / (8 * CHUNK_WIDTH)) * 8 * CHUNK_WIDTH;  // Moves with the coarsest LOD tiles
+        terrain.SetCenter(noise, glm::ivec2(x, 0), glm::ivec2(innerX - inner, -inner), glm::ivec2(innerX + inner, inner));
+    }
+
+    state.SetItemsProcessed(state.GetIterations());  // Moves
+    state.SetCounter("initial_samples", static_cast<double>(initialSamples));
+    state.SetCounter("samples_per_move", static_cast<double>(terrain.GetNbSamples() - initialSamples) / static_cast<double>(state.GetIterations()));
+    state.SetCounter("triangles", static_cast<double>(terrain.GetNbTriangles()));
+}
+BENCHMARK(BM_FarTerrain_Recenter);
+
+// The game's world at its default render distance, generated once and shared by the benchmarks below.
+// Never destroyed: chunks log when released, and the logger is gone by the time statics are torn down.
+static World& GetLoadedWorld() {
+    static World* s_World = nullptr;
+    if (s_World != nullptr) return *s_World;
+
+    s_World = new World();
+    s_World->Init();
+
+    const int distance = s_World->GetChunkManager().GetRenderDistance();
+    for (int z = -distance; z <= distance; z++) {
+        for (int x = -distance; x <= distance; x++) {
+            const Chunk* chunk = s_World->GetChunkManager().GetChunk(glm::ivec3(x, 0, z));
+            while (!chunk->IsDataGenerated()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    return *s_World;
+}
+
+constexpr size_t NB_RANDOM_LOOKUPS = 4096;
+
+// Lookups spread over the whole loaded area, mostly missing the cache
+static void BM_World_GetVoxel_Random(bench::State& state) {
+    const World& world = GetLoadedWorld();
+    const float extent = static_cast<float>(world.GetChunkManager().GetRenderDistance() * CHUNK_WIDTH);
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> horizontal(-extent, extent);
+    std::uniform_real_distribution<float> vertical(0.0f, CHUNK_HEIGHT);
+    std::vector<glm::vec3> positions(NB_RANDOM_LOOKUPS);
+    for (auto& position : positions) position = glm::vec3(horizontal(rng), vertical(rng), horizontal(rng));
+
+    while (state.KeepRunning()) {
+        for (const auto& position : positions) bench::DoNotOptimize(world.GetVoxel(position));
+    }
+
+    state.SetItemsProcessed(state.GetIterations() * NB_RANDOM_LOOKUPS);
+}
+BENCHMARK(BM_World_GetVoxel_Random);
+
+constexpr int SEQUENTIAL_SIZE = 4 * CHUNK_WIDTH;
+
+// Row by row scan of a 4x4 chunks block, the access pattern of collision and meshing neighborhoods
+static void BM_World_GetVoxel_Sequential(bench::State& state) {
+    const World& world = GetLoadedWorld();
+
+    while (state.KeepRunning()) {
+        for (int y = 0; y < CHUNK_HEIGHT; y++) {
+            for (int z = 0; z < SEQUENTIAL_SIZE; z++) {
+                for (int x = 0; x < SEQUENTIAL_SIZE; x++) {
+                    bench::DoNotOptimize(world.GetVoxel(glm::vec3(x, y, z)));
+                }
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.GetIterations() * SEQUENTIAL_SIZE * SEQUENTIAL_SIZE * CHUNK_HEIGHT);
+}
+BENCHMARK(BM_World_GetVoxel_Sequential);
+
+// Gravity and one swept collision step per entity against the generated terrain, on a single thread
+static void BM_CollisionManager_Sweep(bench::State& state) {
+    const World& world = GetLoadedWorld();
+    CollisionManager collisionManager(world);
+    EntityStore store;
+    std::vector<Box> candidates;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> horizontal(-64.0f, 64.0f);
+    std::uniform_real_distribution<float> speed(-4.0f, 4.0f);
+    const size_t nbEntities = static_cast<size_t>(state.Range(0));
+    store.Reserve(nbEntities);
+    for (size_t i = 0; i < nbEntities; i++) {
+        glm::vec3 position(horizontal(rng), CHUNK_HEIGHT - 2.0f, horizontal(rng));
+        EntityID id = store.Create(glm::vec3(.6f, 1.8f, .6f), glm::vec3(.3f, 0.0f, .3f), position, GRAVITY);
+        store.GetVelocities()[store.GetIndex(id)] = glm::vec3(speed(rng), 0.0f, speed(rng));
+    }
+
+    auto& velocities = store.GetVelocities();
+    const auto& gravities = store.GetGravities();
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < store.GetSize(); i++) {
+            velocities[i].y -= gravities[i] * PHYSICS_STEP;
+            collisionManager.Sweep(store, i, PHYSICS_STEP, candidates);
+        }
+    }
+
+    state.SetItemsProcessed(state.GetIterations() * state.Range(0));
+    state.SetCounter("ns_per_entity", state.GetElapsed() * 1e9 / static_cast<double>(state.GetIterations() * state.Range(0)));
+}
+BENCHMARK(BM_CollisionManager_Sweep)->Arg(100)->Arg(1000);
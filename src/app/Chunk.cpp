@@ -1,73 +1,150 @@
 #include "Chunk.h"
 
+#include <cstring>
+
+#include "RegionCache.h"
 #include "events/EventApplication.h"
 #include "events/EventDispatcher.h"
-#include "gfx/Buffer.h"
-#include "gfx/Shader.h"
-#include "gfx/VertexArray.h"
 #include "pch.h"
+#include "utils/Logger.h"
+#include "utils/Profiler.h"
 
 // clang-format off
-const std::unordered_map<Voxel::Face, std::array<float, 16>> Chunk::m_VoxelVertices = {
-    //--- Position ---// // -Static illumination- //
+const std::unordered_map<Voxel::Face, std::array<float, 4 * CHUNK_VERTEX_SIZE>> Chunk::m_VoxelVertices = {
+    //--- Position ---// // -Static illumination- // // -Ambient occlusion- //
 {Voxel::Face::Front, {
-    0.0f, 0.0f,  1.0f,              0.8f,
-    1.0f, 0.0f,  1.0f,              0.8f,
-    1.0f, 1.0f,  1.0f,              0.8f,
-    0.0f, 1.0f,  1.0f,              0.8f,
+    0.0f, 0.0f,  1.0f,              0.8f,              1.0f,
+    1.0f, 0.0f,  1.0f,              0.8f,              1.0f,
+    1.0f, 1.0f,  1.0f,              0.8f,              1.0f,
+    0.0f, 1.0f,  1.0f,              0.8f,              1.0f,
 }},           
 {Voxel::Face::Back, {           
-    1.0f, 0.0f, 0.0f,               0.8f,
-    0.0f, 0.0f, 0.0f,               0.8f,
-    0.0f, 1.0f, 0.0f,               0.8f,
-    1.0f, 1.0f, 0.0f,               0.8f,
+    1.0f, 0.0f, 0.0f,               0.8f,              1.0f,
+    0.0f, 0.0f, 0.0f,               0.8f,              1.0f,
+    0.0f, 1.0f, 0.0f,               0.8f,              1.0f,
+    1.0f, 1.0f, 0.0f,               0.8f,              1.0f,
 }},           
 {Voxel::Face::Left, {           
-    0.0f, 0.0f, 0.0f,               0.8f,
-    0.0f, 0.0f, 1.0f,               0.8f,
-    0.0f, 1.0f, 1.0f,               0.8f,
-    0.0f, 1.0f, 0.0f,               0.8f,
+    0.0f, 0.0f, 0.0f,               0.8f,              1.0f,
+    0.0f, 0.0f, 1.0f,               0.8f,              1.0f,
+    0.0f, 1.0f, 1.0f,               0.8f,              1.0f,
+    0.0f, 1.0f, 0.0f,               0.8f,              1.0f,
 }},           
 {Voxel::Face::Right, {           
-    1.0f, 0.0f, 1.0f,               0.8f,
-    1.0f, 0.0f, 0.0f,               0.8f,
-    1.0f, 1.0f, 0.0f,               0.8f,
-    1.0f, 1.0f, 1.0f,               0.8f,
+    1.0f, 0.0f, 1.0f,               0.8f,              1.0f,
+    1.0f, 0.0f, 0.0f,               0.8f,              1.0f,
+    1.0f, 1.0f, 0.0f,               0.8f,              1.0f,
+    1.0f, 1.0f, 1.0f,               0.8f,              1.0f,
 }},           
 {Voxel::Face::Top, {           
-    0.0f, 1.0f, 1.0f,               1.0f,
-    1.0f, 1.0f, 1.0f,               1.0f,
-    1.0f, 1.0f, 0.0f,               1.0f,
-    0.0f, 1.0f, 0.0f,               1.0f,
+    0.0f, 1.0f, 1.0f,               1.0f,              1.0f,
+    1.0f, 1.0f, 1.0f,               1.0f,              1.0f,
+    1.0f, 1.0f, 0.0f,               1.0f,              1.0f,
+    0.0f, 1.0f, 0.0f,               1.0f,              1.0f,
 }},           
 {Voxel::Face::Bottom, {           
-    0.0f, 0.0f, 0.0f,               0.6f,
-    1.0f, 0.0f, 0.0f,               0.6f,
-    1.0f, 0.0f, 1.0f,               0.6f,
-    0.0f, 0.0f, 1.0f,               0.6f,
+    0.0f, 0.0f, 0.0f,               0.6f,              1.0f,
+    1.0f, 0.0f, 0.0f,               0.6f,              1.0f,
+    1.0f, 0.0f, 1.0f,               0.6f,              1.0f,
+    0.0f, 0.0f, 1.0f,               0.6f,              1.0f,
 }}
 };
 // clang-format on
 
-Chunk::Chunk(glm::ivec3 position) : m_DataGenerated(false), m_MeshGenerated(false), Renderable(position, 1) {
-    // Recover the shader
-    m_Shader = ShaderProgramLibrary::Get().GetShaderProgram("gbuffer_terrain");
+// Indexed by Voxel::Face, matches the vertices above
+static const std::array<glm::ivec3, 6> s_FaceNormals = {
+    glm::ivec3(0, 0, 1), glm::ivec3(0, 0, -1), glm::ivec3(-1, 0, 0), glm::ivec3(1, 0, 0), glm::ivec3(0, 1, 0), glm::ivec3(0, -1, 0),
+};
+
+// Brightness of a light level, each level 80% of the one above like the usual voxel light curves
+static const std::array<float, LIGHT_MAX + 1> s_LightFactors = []() {
+    std::array<float, LIGHT_MAX + 1> factors;
+    for (int level = 0; level <= LIGHT_MAX; level++) factors[level] = std::pow(0.8f, static_cast<float>(LIGHT_MAX - level));
+    return factors;
+}();
+
+// Solid voxels around the mesh for the corner tests, the chunk padded by one voxel on each side. Y innermost like the
+// voxels, see ToGridIndex
+constexpr int OCCLUSION_GRID_WIDTH = CHUNK_WIDTH + 2;
+constexpr int OCCLUSION_GRID_HEIGHT = CHUNK_HEIGHT + 2;
+using OcclusionGrid = std::array<uint8_t, OCCLUSION_GRID_WIDTH * OCCLUSION_GRID_WIDTH * OCCLUSION_GRID_HEIGHT>;
+
+static int ToGridIndex(int x, int y, int z) { return (y + 1) + (x + 1) * OCCLUSION_GRID_HEIGHT + (z + 1) * OCCLUSION_GRID_WIDTH * OCCLUSION_GRID_HEIGHT; }
+
+// Brightness of a vertex by its number of solid neighbors in front of the face, out of 3
+static const std::array<float, 4> s_OcclusionFactors = {1.0f, 0.8f, 0.65f, 0.5f};
+
+static std::atomic<bool> s_AmbientOcclusion = true;
 
-    EventDispatcher::Get().Subscribe(EventCategory::EventCategoryAll, BIND_EVENT_FN(Chunk::OnEvent));
+const std::array<std::array<std::array<int, 3>, 4>, 6> Chunk::m_OcclusionOffsets = []() {
+    std::array<std::array<std::array<int, 3>, 4>, 6> offsets;
+    for (const auto& [face, vertices] : m_VoxelVertices) {
+        const glm::ivec3 normal = s_FaceNormals[face];
+        for (int vertex = 0; vertex < 4; vertex++) {
+            // The two axes along the face, towards the side of the cube the vertex is on
+            std::array<glm::ivec3, 2> sides;
+            int nbSides = 0;
+            for (int axis = 0; axis < 3; axis++) {
+                if (normal[axis] != 0) continue;
+                glm::ivec3 side(0);
+                side[axis] = vertices[vertex * CHUNK_VERTEX_SIZE + axis] > 0.5f ? 1 : -1;
+                sides[nbSides++] = side;
+            }
+            const std::array<glm::ivec3, 3> voxels = {normal + sides[0], normal + sides[1], normal + sides[0] + sides[1]};
+            for (int i = 0; i < 3; i++) offsets[face][vertex][i] = ToGridIndex(voxels[i].x, voxels[i].y, voxels[i].z) - ToGridIndex(0, 0, 0);
+        }
+    }
+    return offsets;
+}();
+
+Chunk::Chunk(glm::ivec3 position)
+    : m_DataGenerated(false), m_MeshGenerated(false), m_LightGenerated(false), m_Dirty(false), Renderable(position, 1) {
+    m_ShaderName = "gbuffer_terrain";
 }
 
-Chunk::~Chunk() { Unregister(); }
+Chunk::~Chunk() {
+    Unregister();
+    Unload();
+}
+
+void Chunk::GenerateData(const Region& region) {
+    PROFILE_SCOPE("Chunk::GenerateData");
+
+    BlockArray blocks;
+    GenerateBlocks(region, glm::ivec3(m_Position), blocks);
+    m_Dirty.store(true, std::memory_order_release);  // Before the data is flagged generated, so an unload saves it
+    SetBlocks(blocks);
+}
+
+void Chunk::GenerateBlocks(const Region& region, const glm::ivec3& position, BlockArray& blocks) {
+    // Heightmap rows copied out of the region
+    std::array<float, CHUNK_WIDTH * CHUNK_WIDTH> noiseValues;
+    for (int z = 0; z < CHUNK_WIDTH; z++) {
+        const float* row = region.GetHeightRow(position.x, position.z + z);
+        std::memcpy(&noiseValues[z * CHUNK_WIDTH], row, CHUNK_WIDTH * sizeof(float));
+    }
 
-void Chunk::GenerateData(const FastNoiseLite& noise) {
-    int boundaryIndex = 0;
     for (int z = 0; z < CHUNK_WIDTH; z++) {
         for (int x = 0; x < CHUNK_WIDTH; x++) {
-            // Calculate the heightmap at position x/z
-            glm::vec3 noiseCoord(m_Position.x + x, 0.0, m_Position.z + z);
-            float noiseValue = noise.GetNoise(noiseCoord.x, noiseCoord.z);
-            // Noise bounded between -1...1, convert between 1...CHUNK_HEIGHT
-            int height = static_cast<int>(((noiseValue + 1.0f) / 2.0f) * (CHUNK_HEIGHT - 1)) + 1;
+            int height = ToColumnHeight(noiseValues[z * CHUNK_WIDTH + x]);
+
+            // Y is the innermost axis, a column is contiguous
+            Block* column = &blocks[ToVoxelIndex(x, 0, z)];
+            for (int y = 0; y < CHUNK_HEIGHT; y++) {
+                column[y] = y > height ? Block::Air : Block::Ground;
+            }
+        }
+    }
+}
+
+void Chunk::SetBlocks(const BlockArray& blocks) {
+    PROFILE_SCOPE("Chunk::SetBlocks");
 
+    m_Blocks = blocks;  // Kept for the light engine and the save, voxels are slow to walk
+
+    int boundaryIndex = 0;
+    for (int z = 0; z < CHUNK_WIDTH; z++) {
+        for (int x = 0; x < CHUNK_WIDTH; x++) {
             // Build blocks on vertical axis
             for (int y = 0; y < CHUNK_HEIGHT; y++) {
                 int index = GetVoxelIndex(glm::vec3(x, y, z));
@@ -89,7 +166,7 @@ void Chunk::GenerateData(const FastNoiseLite& noise) {
                     m_Voxels[index]->SetFaceInvisible(Voxel::Face::Bottom);
                 }
 
-                if (y > height) {
+                if (blocks[index] == Block::Air) {
                     m_Voxels[index]->SetTransparent(true);
                 }
             }
@@ -100,62 +177,119 @@ void Chunk::GenerateData(const FastNoiseLite& noise) {
     EventDispatcher::Get().Dispatch(event);
 }
 
-void Chunk::GenerateMesh() {
+void Chunk::GenerateMesh(const std::array<std::shared_ptr<Chunk>, 4>& neighbors) {
+    PROFILE_SCOPE("Chunk::GenerateMesh");
+
+    // Light of the voxel a face looks into, full sunlight out of the loaded or lit chunks
+    auto getFaceLight = [this, &neighbors](glm::ivec3 coord) -> uint8_t {
+        const Chunk* chunk = this;
+        if (coord.y < 0 || coord.y >= CHUNK_HEIGHT) return LIGHT_MAX;
+        if (coord.x < 0) {
+            chunk = neighbors[X_NEG].get();
+            coord.x += CHUNK_WIDTH;
+        } else if (coord.x >= CHUNK_WIDTH) {
+            chunk = neighbors[X_POS].get();
+            coord.x -= CHUNK_WIDTH;
+        } else if (coord.z < 0) {
+            chunk = neighbors[Z_NEG].get();
+            coord.z += CHUNK_WIDTH;
+        } else if (coord.z >= CHUNK_WIDTH) {
+            chunk = neighbors[Z_POS].get();
+            coord.z -= CHUNK_WIDTH;
+        }
+        if (chunk == nullptr || !chunk->IsLightGenerated()) return LIGHT_MAX;
+
+        const uint8_t light = chunk->GetLight(ToVoxelIndex(coord.x, coord.y, coord.z));
+        return std::max<uint8_t>(light >> 4, light & 0x0F);
+    };
+
+    // Copied once from the blocks, the corner tests read it for every vertex. Diagonal chunks are not passed in and out
+    // of the height is air, so nothing is occluded there
+    const bool ambientOcclusion = IsAmbientOcclusionEnabled();
+    OcclusionGrid grid;
+    if (ambientOcclusion) {
+        grid.fill(0);
+        auto copyColumn = [&grid](const Chunk* chunk, int x, int z, int gridX, int gridZ) {
+            if (chunk == nullptr || !chunk->IsDataGenerated()) return;
+            const Block* column = &chunk->m_Blocks[ToVoxelIndex(x, 0, z)];
+            uint8_t* gridColumn = &grid[ToGridIndex(gridX, 0, gridZ)];
+            for (int y = 0; y < CHUNK_HEIGHT; y++) gridColumn[y] = column[y] != Block::Air;
+        };
+        for (int z = 0; z < CHUNK_WIDTH; z++) {
+            for (int x = 0; x < CHUNK_WIDTH; x++) copyColumn(this, x, z, x, z);
+        }
+        for (int i = 0; i < CHUNK_WIDTH; i++) {
+            copyColumn(neighbors[X_NEG].get(), CHUNK_WIDTH - 1, i, -1, i);
+            copyColumn(neighbors[X_POS].get(), 0, i, CHUNK_WIDTH, i);
+            copyColumn(neighbors[Z_NEG].get(), i, CHUNK_WIDTH - 1, i, -1);
+            copyColumn(neighbors[Z_POS].get(), i, 0, i, CHUNK_WIDTH);
+        }
+    }
+
     for (auto& voxel : m_Voxels) {
         if (voxel->IsTransparent()) continue;
 
         auto cubePos = voxel->GetPosition();
+        const int gridIndex = ToGridIndex(static_cast<int>(cubePos.x), static_cast<int>(cubePos.y), static_cast<int>(cubePos.z));
         // Calculate the vertices position relative to the cube position
-        if (m_Shader == nullptr) {
-            LOG_ERROR("No shader binded for the actual chunk");
-            return;
-        }
-
-        int m_ShaderBufferSize = m_Shader->GetBufferLayout()->GetSize();
         for (auto& [face, vertices] : m_VoxelVertices) {
             if (!voxel->NeedToRenderFace(face)) continue;
             // Copy the non modifiable common vertices into a buffer to edit them
-            std::array<float, 16> movedVertices = vertices;
+            std::array<float, 4 * CHUNK_VERTEX_SIZE> movedVertices = vertices;
+            const float light = s_LightFactors[getFaceLight(glm::ivec3(cubePos) + s_FaceNormals[face])];
+
+            // Classic corner test: both sides solid hide the corner, otherwise each solid voxel darkens the vertex
+            std::array<int, 4> occlusion = {0, 0, 0, 0};
+            if (ambientOcclusion) {
+                for (int vertex = 0; vertex < 4; vertex++) {
+                    const auto& offsets = m_OcclusionOffsets[face][vertex];
+                    const int side1 = grid[gridIndex + offsets[0]];
+                    const int side2 = grid[gridIndex + offsets[1]];
+                    occlusion[vertex] = side1 && side2 ? 3 : side1 + side2 + grid[gridIndex + offsets[2]];
+                }
+            }
 
-            // Edit the new vertices with the cube position in the chunk
-            for (int i = 0; i < vertices.size(); i = i + m_ShaderBufferSize) {
+            // Edit the new vertices with the cube position in the chunk, the face shading is scaled by the light
+            for (int i = 0; i < vertices.size(); i = i + CHUNK_VERTEX_SIZE) {
                 movedVertices[i] += cubePos.x;
                 movedVertices[i + 1] += cubePos.y;
                 movedVertices[i + 2] += cubePos.z;
+                movedVertices[i + 3] *= light;
+                movedVertices[i + 4] = s_OcclusionFactors[occlusion[i / CHUNK_VERTEX_SIZE]];
             }
 
             // Write the new vertices into the final vertex buffer
-            {
-                std::lock_guard<std::mutex> lock(m_Mutex);
-                m_Vertices.insert(m_Vertices.end(), movedVertices.begin(), movedVertices.end());
-            }
+            m_BackMesh.vertices.insert(m_BackMesh.vertices.end(), movedVertices.begin(), movedVertices.end());
 
-            // Update the element buffer
-            AddFaceToIndices();
+            // Update the element buffer. The diagonal keeps off the darker corners, else the shade stretches along it
+            AddFaceToIndices(occlusion[0] + occlusion[2] < occlusion[1] + occlusion[3]);
         }
     }
 
+    CommitMesh();
     m_MeshGenerated.store(true, std::memory_order_release);
     AddNewRenderableEvent event(this);
     EventDispatcher::Get().Dispatch(event);
 }
 
+const glm::ivec3& Chunk::GetFaceNormal(Voxel::Face face) { return s_FaceNormals[face]; }
+
+bool Chunk::IsAmbientOcclusionEnabled() { return s_AmbientOcclusion.load(std::memory_order_relaxed); }
+
+void Chunk::SetAmbientOcclusion(bool enabled) { s_AmbientOcclusion.store(enabled, std::memory_order_relaxed); }
+
 void Chunk::Unload() {
     for (auto& voxel : m_Voxels) {
         delete voxel;
+        voxel = nullptr;  // Unload may run again from the destructor
     }
 }
 
 void Chunk::Update() {}
 
-void Chunk::OnEvent(const Event& event) {
-    if (event.GetType() == EventType::ToggleWireframeView) {
-        const auto* wireframeEvent = dynamic_cast<const ToggleWireframeViewEvent*>(&event);
-        m_Shader->GetUniform("wireframeMode")->SetValue(wireframeEvent->enable);
-    }
-}
-
 void Chunk::RemoveInternalFaces() {
+    PROFILE_SCOPE("Chunk::RemoveInternalFaces");
+
     for (auto& voxel : m_Voxels) {
         for (int i = 0; i < 6; i++) {
             auto face = static_cast<Voxel::Face>(i);
@@ -208,6 +342,8 @@ void Chunk::RemoveInternalFaces() {
 }
 
 void Chunk::RemoveBoundaryFaces(std::array<std::shared_ptr<Chunk>, 4> neighbors) {
+    PROFILE_SCOPE("Chunk::RemoveBoundaryFaces");
+
     glm::vec3 chunkPosition = m_Position;
     chunkPosition.x /= CHUNK_WIDTH;
     chunkPosition.z /= CHUNK_WIDTH;
@@ -1,23 +1,32 @@
 #ifndef __CHUNK_H__
 #define __CHUNK_H__
 
-#include <FastNoiseLite.h>
-
 #include <array>
 #include <atomic>
+#include <cstdint>
 #include <functional>
 #include <glm/glm.hpp>
+#include <memory>
 
 #include "Voxel.h"
 #include "gfx/Renderable.h"
 
-class Event;
-
 constexpr int CHUNK_WIDTH = 16;
 constexpr int CHUNK_HEIGHT = 32;
 constexpr int NB_VOXELS_IN_CHUNK = CHUNK_WIDTH * CHUNK_WIDTH * CHUNK_HEIGHT;
 constexpr int NB_BOUNDARY_VOXELS_IN_CHUNK =
     2 * CHUNK_WIDTH * CHUNK_HEIGHT + 2 * (CHUNK_WIDTH - 2) * CHUNK_HEIGHT + 2 * (CHUNK_WIDTH - 2) * (CHUNK_WIDTH - 2);
+constexpr int CHUNK_VERTEX_SIZE = 5;  // Floats per vertex: position + illumination + occlusion, see the gbuffer_terrain layout
+constexpr uint8_t LIGHT_MAX = 15;     // Light levels per channel, a level drops by one per voxel travelled
+
+// Stored block ids, voxels only keep the transparency today
+enum class Block : uint8_t {
+    Air = 0,
+    Ground = 1,
+};
+using BlockArray = std::array<Block, NB_VOXELS_IN_CHUNK>;  // Indexed like the voxels, see GetVoxelIndex
+
+struct Region;
 
 enum NeighborIndex {
     X_POS = 0,  // +X
@@ -26,19 +35,27 @@ enum NeighborIndex {
     Z_NEG = 3,  // -Z
 };
 
-class Chunk : public Renderable {
+// Shared by the chunk manager and its jobs, which hold weak references to chunks that may be unloaded meanwhile
+class Chunk : public Renderable, public std::enable_shared_from_this<Chunk> {
    public:
     Chunk(glm::ivec3 position);
     ~Chunk();
 
-    void GenerateData(const FastNoiseLite& noise);
-    void GenerateMesh();
+    void GenerateData(const Region& region);  // The region must hold the chunk, see RegionCache
+    // Blocks of the chunk at a world position without building it, the terrain GenerateData fills chunks with
+    static void GenerateBlocks(const Region& region, const glm::ivec3& position, BlockArray& blocks);
+    // Noise bounded between -1...1 to the ground height of a column, between 1...CHUNK_HEIGHT. Voxels up to it are solid
+    static int ToColumnHeight(float noiseValue) { return static_cast<int>(((noiseValue + 1.0f) / 2.0f) * (CHUNK_HEIGHT - 1)) + 1; }
+    void SetBlocks(const BlockArray& blocks);  // Builds the voxels, from generation or from the save
+    void GetBlocks(BlockArray& blocks) const { blocks = m_Blocks; }  // Data must be generated
+    // Rebuilds the whole mesh with the light in front of each face and the ambient occlusion of each vertex baked in,
+    // neighbors give them at the boundaries. A registered chunk keeps drawing its last mesh until the new one is swapped in
+    void GenerateMesh(const std::array<std::shared_ptr<Chunk>, 4>& neighbors = {});
     void Unload();
     void Update() override;
 
     void RemoveInternalFaces();
     void RemoveBoundaryFaces(std::array<std::shared_ptr<Chunk>, 4> neighbors);
-    void OnEvent(const Event& event);
 
     /* Getters */
     glm::ivec3 GetWorldPosition() const {
@@ -46,22 +63,38 @@ class Chunk : public Renderable {
     }
     const bool IsDataGenerated() const { return m_DataGenerated.load(std::memory_order_acquire); }
     const bool IsMeshGenerated() const { return m_MeshGenerated.load(std::memory_order_acquire); }
+    bool IsLightGenerated() const { return m_LightGenerated.load(std::memory_order_acquire); }
+    bool IsDirty() const { return m_Dirty.load(std::memory_order_acquire); }  // Blocks differ from the save, since generation or an edit
     Voxel* GetVoxelatCoord(const glm::vec3& coord);
 
+    static int ToVoxelIndex(int x, int y, int z) { return y + x * CHUNK_HEIGHT + z * CHUNK_WIDTH * CHUNK_HEIGHT; }
+    bool IsOpaque(int index) const { return m_Blocks[index] != Block::Air; }
+    // Sunlight in the high nibble, block light in the low one. Written by the LightEngine only, read by any thread
+    uint8_t GetLight(int index) const { return m_Light[index].load(std::memory_order_relaxed); }
+    // Corners with their shading and occlusion then the normal of a unit cube face, as the mesh lays them out
+    static const std::array<float, 4 * CHUNK_VERTEX_SIZE>& GetFaceVertices(Voxel::Face face) { return m_VoxelVertices.at(face); }
+    static const glm::ivec3& GetFaceNormal(Voxel::Face face);
+    static bool IsAmbientOcclusionEnabled();
+
+    /* Setters */
+    void SetDirty(bool dirty) { m_Dirty.store(dirty, std::memory_order_release); }  // Cleared once the blocks are saved
+    static void SetAmbientOcclusion(bool enabled);  // For the meshes built afterwards, on by default
+
    private:
+    friend class LightEngine;
+
     std::atomic<bool> m_DataGenerated;
     std::atomic<bool> m_MeshGenerated;
+    std::atomic<bool> m_LightGenerated;
+    std::atomic<bool> m_Dirty;
+    BlockArray m_Blocks;
+    std::array<std::atomic<uint8_t>, NB_VOXELS_IN_CHUNK> m_Light = {};
     std::array<Voxel*, CHUNK_WIDTH * CHUNK_WIDTH * CHUNK_HEIGHT> m_Voxels = {nullptr};
     std::array<Voxel*, NB_BOUNDARY_VOXELS_IN_CHUNK> m_BoundaryVoxels;
 
-    // Uniforms for shader
-    bool m_UniformToggleWireframe = false;
-    glm::vec3 m_UniformWireframeColor = glm::vec3(0.0f);
-    int m_UniformFogStart = 0;
-    int m_UniformFogEnd = 0;
-    glm::vec3 m_UniformFogColor = glm::vec3(0.0f);
-
-    static const std::unordered_map<Voxel::Face, std::array<float, 16>> m_VoxelVertices;  // A map of arrays for cube vertices
+    static const std::unordered_map<Voxel::Face, std::array<float, 4 * CHUNK_VERTEX_SIZE>> m_VoxelVertices;  // A map of arrays for cube vertices
+    // Grid offsets of the two side voxels and the corner voxel in front of each vertex, by face then vertex
+    static const std::array<std::array<std::array<int, 3>, 4>, 6> m_OcclusionOffsets;
 
     // Private methods
     glm::vec3 GetVoxelCoord(int index);
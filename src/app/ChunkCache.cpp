@@ -0,0 +1,69 @@
+#include "ChunkCache.h"
+
+#include "pch.h"
+
+// Map node, list node and vector header of an entry, on top of the payload itself
+constexpr size_t CHUNK_CACHE_ENTRY_OVERHEAD = sizeof(glm::ivec2) * 2 + sizeof(void*) * 4 + sizeof(std::vector<uint8_t>) + 16;
+
+ChunkCache::ChunkCache(size_t budget) : m_Bytes(0), m_Budget(budget), m_NbHits(0), m_NbEvicted(0) {}
+
+void ChunkCache::Insert(const glm::ivec2& chunkCoord, std::vector<uint8_t>&& payload) {
+    auto it = m_Entries.find(chunkCoord);
+    if (it != m_Entries.end()) Erase(it);
+
+    payload.shrink_to_fit();  // Encoded into a growing vector, the slack would count against the budget
+    m_LRU.push_front(chunkCoord);
+    auto& entry = m_Entries[chunkCoord];
+    entry = {std::move(payload), m_LRU.begin()};
+    m_Bytes += GetEntryBytes(entry);
+
+    EvictToBudget();
+}
+
+bool ChunkCache::Take(const glm::ivec2& chunkCoord, std::vector<uint8_t>& payload) {
+    auto it = m_Entries.find(chunkCoord);
+    if (it == m_Entries.end()) return false;
+
+    m_Bytes -= GetEntryBytes(it->second);
+    payload = std::move(it->second.payload);
+    m_LRU.erase(it->second.lruPosition);
+    m_Entries.erase(it);
+    m_NbHits++;
+    return true;
+}
+
+void ChunkCache::EvictOutside(const glm::ivec2& center, int distance) {
+    for (auto it = m_Entries.begin(); it != m_Entries.end();) {
+        const glm::ivec2 offset = glm::abs(it->first - center);
+        auto next = std::next(it);
+        if (offset.x > distance || offset.y > distance) Erase(it);
+        it = next;
+    }
+}
+
+void ChunkCache::Clear() {
+    m_Entries.clear();
+    m_LRU.clear();
+    m_Bytes = 0;
+}
+
+void ChunkCache::SetBudget(size_t budget) {
+    m_Budget = budget;
+    EvictToBudget();
+}
+
+size_t ChunkCache::GetEntryBytes(const Entry& entry) { return CHUNK_CACHE_ENTRY_OVERHEAD + entry.payload.capacity(); }
+
+void ChunkCache::Erase(std::unordered_map<glm::ivec2, Entry>::iterator it) {
+    m_Bytes -= GetEntryBytes(it->second);
+    m_LRU.erase(it->second.lruPosition);
+    m_Entries.erase(it);
+}
+
+void ChunkCache::EvictToBudget() {
+    // Least recently unloaded first, the chunks the player left the longest ago
+    while (m_Bytes > m_Budget && !m_LRU.empty()) {
+        Erase(m_Entries.find(m_LRU.back()));
+        m_NbEvicted++;
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef __CHUNK_CACHE_H__
+#define __CHUNK_CACHE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+constexpr size_t CHUNK_CACHE_BUDGET = 32 * 1024 * 1024;  // Bytes, thousands of terrain chunks at a few hundred bytes each
+constexpr int CHUNK_CACHE_MARGIN = 8;                     // Chunks kept cold beyond the render distance
+
+// Cold tier of the chunk manager: chunks out of the render distance keep only their ChunkCodec payload here, without
+// voxels or mesh, so coming back decodes them instead of regenerating. LRU within a byte budget, main thread only.
+class ChunkCache {
+   public:
+    ChunkCache(size_t budget = CHUNK_CACHE_BUDGET);
+
+    // Chunk coordinates as in ChunkManager, replaces a previous payload of the same chunk
+    void Insert(const glm::ivec2& chunkCoord, std::vector<uint8_t>&& payload);
+    // Moves the payload out on a hit, the chunk is hot again and leaves the cache
+    bool Take(const glm::ivec2& chunkCoord, std::vector<uint8_t>& payload);
+
+    // Drops the chunks further than distance from center, on either axis like the loaded square
+    void EvictOutside(const glm::ivec2& center, int distance);
+    void Clear();
+
+    /* Getters */
+    size_t GetSize() const { return m_Entries.size(); }
+    size_t GetBytes() const { return m_Bytes; }
+    size_t GetBudget() const { return m_Budget; }
+    size_t GetNbHits() const { return m_NbHits; }
+    size_t GetNbEvicted() const { return m_NbEvicted; }  // Dropped for the budget, not for the distance
+
+    /* Setters */
+    void SetBudget(size_t budget);
+
+   private:
+    struct Entry {
+        std::vector<uint8_t> payload;
+        std::list<glm::ivec2>::iterator lruPosition;
+    };
+
+    static size_t GetEntryBytes(const Entry& entry);
+    void Erase(std::unordered_map<glm::ivec2, Entry>::iterator it);
+    void EvictToBudget();
+
+    std::unordered_map<glm::ivec2, Entry> m_Entries;
+    std::list<glm::ivec2> m_LRU;  // Most recently inserted first
+    size_t m_Bytes;
+    size_t m_Budget;
+    size_t m_NbHits;
+    size_t m_NbEvicted;
+};
+
+#endif  // __CHUNK_CACHE_H__
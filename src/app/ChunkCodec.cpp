@@ -0,0 +1,251 @@
+#include "ChunkCodec.h"
+
+#include <cstring>
+
+#include "pch.h"
+
+namespace ChunkCodec {
+
+constexpr size_t NB_BLOCK_IDS = 256;
+constexpr uint8_t MAX_BLOCK_ID = static_cast<uint8_t>(Block::Ground);  // Higher palette ids are not blocks, so corruption
+constexpr uint16_t NO_PALETTE_INDEX = 0xFFFF;
+constexpr size_t NB_COLUMNS = CHUNK_WIDTH * CHUNK_WIDTH;
+constexpr size_t MAX_PACKED_PALETTE_SIZE = 8;                 // Palette indices that fit in the 3 high bits of a packed run
+constexpr size_t MAX_RUNS_SIZE = NB_COLUMNS * CHUNK_HEIGHT * 2;  // Every voxel its own two byte run
+static_assert(CHUNK_HEIGHT <= 32, "Packed runs store length - 1 in 5 bits");
+static_assert(MAX_RUNS_SIZE <= 0xFFFF, "Runs size and LZ offsets are 16 bits");
+
+constexpr size_t LZ_MIN_MATCH = 4;
+constexpr int LZ_HASH_BITS = 12;
+constexpr size_t LZ_TOKEN_MAX = 15;
+
+static bool IsPaletteValid(const uint8_t* palette, size_t paletteSize) {
+    return std::all_of(palette, palette + paletteSize, [](uint8_t id) { return id <= MAX_BLOCK_ID; });
+}
+
+// Version 1
+
+constexpr uint8_t VERSION_PALETTE_RLE = 1;
+
+static bool DecodeVersion1(const uint8_t* data, size_t size, BlockArray& blocks) {
+    const size_t paletteSize = data[1];
+    if (paletteSize == 0 || size < 2 + paletteSize) return false;
+    const uint8_t* palette = data + 2;
+    if (!IsPaletteValid(palette, paletteSize)) return false;
+
+    size_t position = 2 + paletteSize;
+    size_t nbDecoded = 0;
+    while (position + 3 <= size) {
+        const uint8_t index = data[position];
+        const size_t length = data[position + 1] | (data[position + 2] << 8);
+        position += 3;
+
+        if (index >= paletteSize || length == 0 || nbDecoded + length > blocks.size()) return false;
+        std::fill_n(blocks.begin() + nbDecoded, length, static_cast<Block>(palette[index]));
+        nbDecoded += length;
+    }
+    return position == size && nbDecoded == blocks.size();
+}
+
+// LZ stage
+
+static uint32_t Load32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static void WriteLength(std::vector<uint8_t>& out, size_t length) {
+    for (; length >= 255; length -= 255) out.push_back(255);
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+static void WriteSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t nbLiterals, size_t offset, size_t matchLength) {
+    const size_t matchCode = matchLength - LZ_MIN_MATCH;
+    out.push_back(static_cast<uint8_t>((std::min(nbLiterals, LZ_TOKEN_MAX) << 4) | std::min(matchCode, LZ_TOKEN_MAX)));
+    if (nbLiterals >= LZ_TOKEN_MAX) WriteLength(out, nbLiterals - LZ_TOKEN_MAX);
+    out.insert(out.end(), literals, literals + nbLiterals);
+
+    if (matchLength == 0) return;  // Last sequence
+    out.push_back(static_cast<uint8_t>(offset & 0xFF));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (matchCode >= LZ_TOKEN_MAX) WriteLength(out, matchCode - LZ_TOKEN_MAX);
+}
+
+// Greedy single probe matcher: one hash table lookup per position, enough for the repetitive run streams of terrain
+static void CompressLZ(const uint8_t* in, size_t size, std::vector<uint8_t>& out) {
+    std::array<int32_t, 1 << LZ_HASH_BITS> table;
+    table.fill(-1);
+
+    size_t anchor = 0;
+    size_t position = 0;
+    while (position + LZ_MIN_MATCH <= size) {
+        const uint32_t sequence = Load32(in + position);
+        const uint32_t hash = (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+        const int32_t candidate = table[hash];
+        table[hash] = static_cast<int32_t>(position);
+
+        if (candidate < 0 || Load32(in + candidate) != sequence) {
+            position++;
+            continue;
+        }
+
+        size_t length = LZ_MIN_MATCH;
+        while (position + length < size && in[candidate + length] == in[position + length]) length++;
+        WriteSequence(out, in + anchor, position - anchor, position - candidate, length);
+        position += length;
+        anchor = position;
+    }
+    WriteSequence(out, in + anchor, size - anchor, 0, 0);
+}
+
+static bool ReadLength(const uint8_t*& in, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+    do {
+        if (in >= end) return false;
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+static bool DecompressLZ(const uint8_t* in, size_t size, uint8_t* out, size_t outSize) {
+    const uint8_t* end = in + size;
+    size_t written = 0;
+    bool lastSequence = false;  // Streams always end with a literals only sequence, a cut after a match is caught
+    while (in < end) {
+        const uint8_t token = *in++;
+
+        size_t nbLiterals = token >> 4;
+        if (nbLiterals == LZ_TOKEN_MAX && !ReadLength(in, end, nbLiterals)) return false;
+        if (nbLiterals > static_cast<size_t>(end - in) || nbLiterals > outSize - written) return false;
+        std::memcpy(out + written, in, nbLiterals);
+        in += nbLiterals;
+        written += nbLiterals;
+        if (in == end) {
+            lastSequence = true;
+            break;
+        }
+
+        if (end - in < 2) return false;
+        const size_t offset = in[0] | (in[1] << 8);
+        in += 2;
+        size_t matchLength = token & 0x0F;
+        if (matchLength == LZ_TOKEN_MAX && !ReadLength(in, end, matchLength)) return false;
+        matchLength += LZ_MIN_MATCH;
+        if (offset == 0 || offset > written || matchLength > outSize - written) return false;
+
+        // Byte by byte, matches may overlap their own output
+        for (size_t i = 0; i < matchLength; i++, written++) out[written] = out[written - offset];
+    }
+    return lastSequence && written == outSize;
+}
+
+// Version 2
+
+void Encode(const BlockArray& blocks, std::vector<uint8_t>& out) {
+    // Palette in order of first appearance
+    std::array<uint16_t, NB_BLOCK_IDS> paletteIndex;
+    paletteIndex.fill(NO_PALETTE_INDEX);
+    std::array<uint8_t, NB_BLOCK_IDS> palette;
+    size_t paletteSize = 0;
+    for (Block block : blocks) {
+        const uint8_t id = static_cast<uint8_t>(block);
+        if (paletteIndex[id] == NO_PALETTE_INDEX) {
+            paletteIndex[id] = static_cast<uint16_t>(paletteSize);
+            palette[paletteSize++] = id;
+        }
+    }
+    const bool packed = paletteSize <= MAX_PACKED_PALETTE_SIZE;
+
+    // Runs along each column
+    std::array<uint8_t, MAX_RUNS_SIZE> runs;
+    size_t runsSize = 0;
+    for (size_t column = 0; column < NB_COLUMNS; column++) {
+        const Block* voxels = &blocks[column * CHUNK_HEIGHT];
+        int y = 0;
+        while (y < CHUNK_HEIGHT) {
+            int end = y + 1;
+            while (end < CHUNK_HEIGHT && voxels[end] == voxels[y]) end++;
+
+            const uint8_t index = static_cast<uint8_t>(paletteIndex[static_cast<uint8_t>(voxels[y])]);
+            if (packed) {
+                runs[runsSize++] = static_cast<uint8_t>((index << 5) | (end - y - 1));
+            } else {
+                runs[runsSize++] = index;
+                runs[runsSize++] = static_cast<uint8_t>(end - y - 1);
+            }
+            y = end;
+        }
+    }
+
+    out.push_back(CHUNK_CODEC_VERSION);
+    out.push_back(static_cast<uint8_t>(paletteSize - 1));
+    out.insert(out.end(), palette.begin(), palette.begin() + paletteSize);
+    const size_t flagsPosition = out.size();
+    out.push_back(CHUNK_CODEC_LZ);
+    out.push_back(static_cast<uint8_t>(runsSize & 0xFF));
+    out.push_back(static_cast<uint8_t>(runsSize >> 8));
+
+    // Runs stored as they are when LZ does not pay off
+    const size_t bodyPosition = out.size();
+    CompressLZ(runs.data(), runsSize, out);
+    if (out.size() - bodyPosition >= runsSize) {
+        out.resize(bodyPosition);
+        out.insert(out.end(), runs.begin(), runs.begin() + runsSize);
+        out[flagsPosition] = 0;
+    }
+}
+
+bool Decode(const uint8_t* data, size_t size, BlockArray& blocks) {
+    if (size < 2) return false;
+    if (data[0] == VERSION_PALETTE_RLE) return DecodeVersion1(data, size, blocks);
+    if (data[0] != CHUNK_CODEC_VERSION) return false;
+
+    const size_t paletteSize = static_cast<size_t>(data[1]) + 1;
+    if (size < 2 + paletteSize + 3) return false;
+    const uint8_t* palette = data + 2;
+    if (!IsPaletteValid(palette, paletteSize)) return false;
+    const uint8_t* header = palette + paletteSize;
+    const uint8_t flags = header[0];
+    const size_t runsSize = header[1] | (header[2] << 8);
+    const uint8_t* body = header + 3;
+    const size_t bodySize = size - (body - data);
+    if (runsSize > MAX_RUNS_SIZE) return false;
+
+    std::array<uint8_t, MAX_RUNS_SIZE> buffer;
+    const uint8_t* runs = body;
+    if (flags & CHUNK_CODEC_LZ) {
+        if (!DecompressLZ(body, bodySize, buffer.data(), runsSize)) return false;
+        runs = buffer.data();
+    } else if (bodySize != runsSize) {
+        return false;
+    }
+
+    const bool packed = paletteSize <= MAX_PACKED_PALETTE_SIZE;
+    size_t position = 0;
+    for (size_t column = 0; column < NB_COLUMNS; column++) {
+        Block* voxels = &blocks[column * CHUNK_HEIGHT];
+        size_t y = 0;
+        while (y < CHUNK_HEIGHT) {
+            size_t index, length;
+            if (packed) {
+                if (position >= runsSize) return false;
+                index = runs[position] >> 5;
+                length = (runs[position] & 0x1F) + 1;
+                position += 1;
+            } else {
+                if (position + 2 > runsSize) return false;
+                index = runs[position];
+                length = static_cast<size_t>(runs[position + 1]) + 1;
+                position += 2;
+            }
+            if (index >= paletteSize || y + length > CHUNK_HEIGHT) return false;
+            std::fill_n(voxels + y, length, static_cast<Block>(palette[index]));
+            y += length;
+        }
+    }
+    return position == runsSize;
+}
+
+}  // namespace ChunkCodec
@@ -0,0 +1,33 @@
+#ifndef __CHUNK_CODEC_H__
+#define __CHUNK_CODEC_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Chunk.h"
+
+constexpr uint8_t CHUNK_CODEC_VERSION = 2;
+
+// Serialized chunk blocks, for the region files and the in-memory copies of inactive chunks.
+// Version 2, what Encode writes:
+//   u8 version | u8 palette size - 1 | palette: block ids in order of appearance | u8 flags | u16 runs size | runs
+//   Runs follow each Y column (innermost axis, see Chunk::GetVoxelIndex) and never cross columns:
+//   one byte (palette index << 5 | length - 1) with up to 8 palette entries, else two bytes (palette index, length - 1).
+//   With CHUNK_CODEC_LZ in flags the runs are LZ compressed: sequences of
+//   token (literals length << 4 | match length - 4) | extra literals length | literals | u16 match offset | extra match length
+//   where a 15 in the token is followed by extra length bytes (255 means another byte follows), the last sequence has no match.
+// Version 1 (palette and u8 index, u16 length runs over the whole chunk) is still decoded for the first region files.
+namespace ChunkCodec {
+
+constexpr uint8_t CHUNK_CODEC_LZ = 1 << 0;
+
+// Appends the payload to out
+void Encode(const BlockArray& blocks, std::vector<uint8_t>& out);
+
+// False on a truncated or corrupted payload or a palette id that is no Block, blocks is then left partially written
+bool Decode(const uint8_t* data, size_t size, BlockArray& blocks);
+
+}  // namespace ChunkCodec
+
+#endif  // __CHUNK_CODEC_H__
@@ -1,67 +1,375 @@
 #include "ChunkManager.h"
 
+#include <tuple>
+
 #include "Chunk.h"
+#include "ChunkCodec.h"
 #include "core/ThreadPool.h"
+#include "gfx/Renderable.h"
 #include "events/EventApplication.h"
 #include "events/EventDispatcher.h"
-#include "gfx/Shader.h"
+#include "utils/Logger.h"
+#include "utils/Profiler.h"
+
+constexpr size_t LOD_TILES_REGISTERED_PER_FRAME = 16;
 
-ChunkManager::ChunkManager() : m_RenderDistance(16), m_NbChunksWithData(0) {
-    EventDispatcher::Get().Subscribe(EventCategory::EventCategoryApplication, BIND_EVENT_FN(ChunkManager::OnEvent));
+ChunkManager::ChunkManager()
+    : m_RenderDistance(16),
+      m_Center(0),
+      m_Regions(std::make_shared<RegionCache>(Noise())),
+      m_Lighting(std::make_shared<LightEngine>()),
+      m_RingTriangles{},
+      m_EventListener(BIND_EVENT_FN(ChunkManager::OnEvent)) {
+    EventDispatcher::Get().Subscribe(EventCategory::EventCategoryApplication, m_EventListener);
 }
 
 ChunkManager::~ChunkManager() {
+    // Jobs still queued dispatch their meshes after the manager is gone
+    EventDispatcher::Get().Unsubscribe(EventCategory::EventCategoryApplication, m_EventListener);
+    if (m_Store) m_Store->Flush();  // Queued jobs may still save, what was generated so far is kept
+
     while (!m_ChunksToRender.empty()) {
         m_ChunksToRender.pop();  // Empty the render queue
     }
+    while (!m_LodTilesToRender.empty()) m_LodTilesToRender.pop();
+
+    // Queued jobs may drop the last references on a worker, so the draw set is left here. Retired ones already left it
+    for (const auto& [position, chunk] : m_Chunks) chunk->Unregister();
+    for (const auto& [key, tile] : m_LodTiles) tile->Unregister();
+    for (const auto& tile : m_LodTilesToRetire) tile->Unregister();
     m_Chunks.clear();  // Clear the chunk map
+    m_LodTiles.clear();
+    m_LodTilesToRetire.clear();
+    m_RetiredChunks.clear();
 }
 
-void ChunkManager::Init() {
-    for (int z = -m_RenderDistance; z <= m_RenderDistance; z++) {
-        for (int x = -m_RenderDistance; x <= m_RenderDistance; x++) {
-            LoadChunk(glm::vec3(x, 0, z));
-        }
+void ChunkManager::Init(const std::string& savePath) {
+    LOG_INFO("Terrain noise: {0} kernel", Noise::GetBackendName(m_Regions->GetNoise().GetBackend()));
+    if (!savePath.empty()) {
+        m_Store = std::make_shared<RegionStore>(savePath);
+        LOG_INFO("World saved in '{0}'", savePath);
     }
+
+    LoadMissingChunks();
+    UpdateLodTiles();
+    UpdateFarTerrain();
 }
 
 void ChunkManager::Update() {
-    if (m_NbChunksWithData >= m_Chunks.size()) {
-        if (!m_ChunksToMesh.empty()) {
-            auto& chunk = m_ChunksToMesh.front();
-            glm::ivec3 position = static_cast<glm::ivec3>(chunk->GetPosition());
-            ThreadPool::Get().Enqueue([this, position, chunkPtr = chunk]() {
-                chunkPtr->RemoveInternalFaces();
-                chunkPtr->RemoveBoundaryFaces(GetNeighbors(position));
-                chunkPtr->GenerateMesh();
-            });
+    PROFILE_SCOPE("ChunkManager::Update");
 
+    // Released here so GPU buffers and the renderables set are only touched by the main thread
+    std::erase_if(m_RetiredChunks, [](const std::shared_ptr<Renderable>& chunk) { return chunk.use_count() == 1; });
+
+    // One chunk meshed per frame, once its loaded neighbors have their data for the boundary faces
+    while (!m_ChunksToMesh.empty()) {
+        auto chunk = m_ChunksToMesh.front().lock();
+        if (!IsLoaded(chunk)) {
             m_ChunksToMesh.pop();
+            continue;
         }
 
-        if (!m_ChunksToRender.empty()) {
-            m_ChunksToRender.front()->Register();
+        // Looked up here, the chunk map belongs to the main thread
+        auto area = GetArea(chunk);
+        auto neighbors = GetNeighbors(area);
+        bool ready = chunk->IsDataGenerated();
+        for (const auto& neighbor : neighbors) ready = ready && (!neighbor || neighbor->IsDataGenerated());
+        if (!ready) break;
+
+        m_ChunksMeshing.insert(chunk.get());
+        ThreadPool::Get().Enqueue(JobLane::Meshing, [chunkPtr = std::move(chunk), area = std::move(area), neighbors = std::move(neighbors), lighting = m_Lighting]() {
+            chunkPtr->RemoveInternalFaces();
+            chunkPtr->RemoveBoundaryFaces(neighbors);
+            lighting->LightChunk(area);
+            chunkPtr->GenerateMesh(neighbors);
+        });
+        m_ChunksToMesh.pop();
+        break;
+    }
+
+    // Meshed chunks whose light changed are rebuilt, once their mesh in flight is committed
+    m_Lighting->TakeDirtyChunks(m_ChunksToRelight);
+    std::unordered_set<Chunk*> relit;
+    std::erase_if(m_ChunksToRelight, [this, &relit](const std::weak_ptr<Chunk>& weakChunk) {
+        auto chunk = weakChunk.lock();
+        if (!IsLoaded(chunk) || !relit.insert(chunk.get()).second) return true;
+        if (m_ChunksMeshing.contains(chunk.get())) return false;
+        if (!chunk->IsMeshGenerated()) return true;  // Its first mesh is still to come and will see the new light
+
+        m_ChunksMeshing.insert(chunk.get());
+        ThreadPool::Get().Enqueue(JobLane::Meshing, [chunkPtr = chunk, neighbors = GetNeighbors(GetArea(chunk))]() { chunkPtr->GenerateMesh(neighbors); });
+        return true;
+    });
+
+    // One new chunk registered per frame. Remeshed chunks are already drawn, the renderer swaps their mesh in by itself
+    std::shared_ptr<Chunk> chunkToRender;
+    {
+        std::lock_guard<std::mutex> lock(m_RenderQueueMutex);
+        while (!m_ChunksToRender.empty() && !chunkToRender) {
+            auto chunk = m_ChunksToRender.front().lock();
             m_ChunksToRender.pop();
+            if (!IsLoaded(chunk)) continue;
+
+            m_ChunksMeshing.erase(chunk.get());
+            if (!chunk->IsRegistered()) chunkToRender = std::move(chunk);
+        }
+    }
+    if (chunkToRender) chunkToRender->Register();
+
+    // Tiles are cheap to register and far more numerous, a few per frame
+    std::vector<std::shared_ptr<LodTile>> tilesToRender;
+    {
+        std::lock_guard<std::mutex> lock(m_RenderQueueMutex);
+        while (!m_LodTilesToRender.empty() && tilesToRender.size() < LOD_TILES_REGISTERED_PER_FRAME) {
+            auto tile = m_LodTilesToRender.front().lock();
+            m_LodTilesToRender.pop();
+            if (IsLoaded(tile)) tilesToRender.push_back(std::move(tile));
         }
     }
+    for (auto& tile : tilesToRender) tile->Register();
+
+    RetireLodTiles();
+    CountRingTriangles();
+}
+
+void ChunkManager::SetLightSource(const glm::ivec3& worldVoxel, uint8_t level) {
+    if (worldVoxel.y < 0 || worldVoxel.y >= CHUNK_HEIGHT) return;  // Above or below the chunks, nothing to light
+    auto it = m_Chunks.find(ToChunkCoord(worldVoxel));
+    if (it == m_Chunks.end()) return;
+
+    ThreadPool::Get().Enqueue(JobLane::Meshing,
+                              [lighting = m_Lighting, area = GetArea(it->second), worldVoxel, level]() { lighting->SetSource(area, worldVoxel, level); });
+}
+
+void ChunkManager::SetCenter(const glm::ivec3& chunkCoord) {
+    if (chunkCoord == m_Center) return;
+    PROFILE_SCOPE("ChunkManager::SetCenter");
+    m_Center = chunkCoord;
+
+    std::vector<glm::ivec3> chunksToUnload;
+    for (const auto& [position, chunk] : m_Chunks) {
+        if (GetLodLevel(position) != 0) chunksToUnload.push_back(position);
+    }
+    for (const auto& position : chunksToUnload) UnloadChunk(position);
+
+    LoadMissingChunks();
+    UpdateLodTiles();
+    UpdateFarTerrain();
+    m_ColdChunks.EvictOutside(glm::ivec2(m_Center.x, m_Center.z), GetCacheDistance());
 }
 
 void ChunkManager::LoadChunk(const glm::vec3& position) {
-    m_Chunks.emplace(position, std::make_shared<Chunk>(glm::ivec3(position.x * CHUNK_WIDTH, 0, position.z * CHUNK_WIDTH)));
+    if (m_Chunks.contains(position)) return;
 
-    auto& chunk = m_Chunks[position];
-    m_ChunksToMesh.push(chunk.get());  // Register the chunk into the vector to iterate later
-    chunk->GetShader()->GetUniform("wireframeColor")->SetValue(glm::vec3(1.0f, 1.0f, 1.0f));
-    chunk->GetShader()->GetUniform("fogStart")->SetValue(static_cast<float>(m_RenderDistance * CHUNK_WIDTH - 16));
-    chunk->GetShader()->GetUniform("fogEnd")->SetValue(static_cast<float>(m_RenderDistance * CHUNK_WIDTH));
-    chunk->GetShader()->GetUniform("fogColor")->SetValue(glm::vec3(0.1f, 0.1f, 0.1f));
+    auto chunk = std::make_shared<Chunk>(glm::ivec3(position.x * CHUNK_WIDTH, 0, position.z * CHUNK_WIDTH));
+    m_Chunks.emplace(position, chunk);
+    m_ChunksToMesh.push(chunk);  // Register the chunk into the queue to mesh later
 
-    // Send chunk generation in threads
-    auto& noise = m_Noise;
-    ThreadPool::Get().Enqueue([chunkPtr = chunk, noise]() { chunkPtr->GenerateData(noise); });  // Create a chunkPtr copy to avoid chunk destruction
+    // A cold chunk takes its payload back, decoding it is cheaper than reading the save or generating
+    const glm::ivec2 coord(position.x, position.z);
+    std::vector<uint8_t> payload;
+    m_ColdChunks.Take(coord, payload);
+
+    // Send chunk generation in threads: cold chunks are decoded, saved chunks read back, the others generated then saved.
+    // Chunks of a region share its heightmap, the first job to need it generates it
+    ThreadPool::Get().Enqueue([chunkPtr = std::move(chunk), regions = m_Regions, store = m_Store, coord, payload = std::move(payload)]() {
+        BlockArray blocks;
+        if (!payload.empty() && ChunkCodec::Decode(payload.data(), payload.size(), blocks)) {
+            chunkPtr->SetBlocks(blocks);
+            return;
+        }
+        if (store && store->Load(coord, blocks)) {
+            chunkPtr->SetBlocks(blocks);
+            return;
+        }
+
+        const glm::vec3& chunkPosition = chunkPtr->GetPosition();
+        chunkPtr->GenerateData(*regions->GetRegion(static_cast<int>(chunkPosition.x), static_cast<int>(chunkPosition.z)));
+        if (store) {
+            chunkPtr->GetBlocks(blocks);
+            store->Save(coord, blocks);
+            chunkPtr->SetDirty(false);
+        }
+    });
 }
 
-void ChunkManager::UnloadChunk(const glm::vec3& position) { m_Chunks.erase(position); }
+void ChunkManager::UnloadChunk(const glm::vec3& position) {
+    auto it = m_Chunks.find(position);
+    if (it == m_Chunks.end()) return;
+
+    // Encoded once for the cold tier and, when it changed since it was saved, the save. The voxels and the CPU mesh are
+    // freed with the chunk
+    if (it->second->IsDataGenerated()) {
+        const glm::ivec2 coord(position.x, position.z);
+        BlockArray blocks;
+        it->second->GetBlocks(blocks);
+        std::vector<uint8_t> payload;
+        ChunkCodec::Encode(blocks, payload);
+        if (m_Store && it->second->IsDirty()) m_Store->Save(coord, payload);
+        m_ColdChunks.Insert(coord, std::move(payload));
+    }
+
+    it->second->Unregister();
+    m_ChunksMeshing.erase(it->second.get());
+    if (it->second.use_count() > 1) m_RetiredChunks.push_back(std::move(it->second));
+    m_Chunks.erase(it);
+}
+
+void ChunkManager::LoadMissingChunks() {
+    // The loaded square follows the 2x2 tiles of the first LOD ring, it may reach one chunk past the render distance
+    const int distance = m_RenderDistance + 1;
+    for (int z = m_Center.z - distance; z <= m_Center.z + distance; z++) {
+        for (int x = m_Center.x - distance; x <= m_Center.x + distance; x++) {
+            if (GetLodLevel(glm::ivec3(x, 0, z)) == 0) LoadChunk(glm::vec3(x, 0, z));
+        }
+    }
+}
+
+void ChunkManager::UpdateLodTiles() {
+    PROFILE_SCOPE("ChunkManager::UpdateLodTiles");
+
+    std::unordered_set<glm::ivec3> wanted;
+    const int distance = GetFarDistance() + LodTile::GetSize(LOD_MAX_LEVEL);
+
+    // Every region under the tiles stays cached, a tile would otherwise regenerate the regions its neighbors evicted
+    const size_t nbRegionsPerSide = static_cast<size_t>((2 * distance + 1) / REGION_SIZE + 2);
+    m_Regions->SetCapacity(std::max(REGION_CACHE_CAPACITY, nbRegionsPerSide * nbRegionsPerSide));
+
+    for (int z = m_Center.z - distance; z <= m_Center.z + distance; z++) {
+        for (int x = m_Center.x - distance; x <= m_Center.x + distance; x++) {
+            const glm::ivec3 coord(x, 0, z);
+            const int level = GetLodLevel(coord);
+            if (level > 0 && level < LOD_NB_LEVELS) wanted.insert(ToTileKey(coord, level));
+        }
+    }
+
+    // Tiles of another level or out of range stay drawn until the area they cover is drawn again, see RetireLodTiles
+    for (auto it = m_LodTiles.begin(); it != m_LodTiles.end();) {
+        if (wanted.erase(it->first) > 0) {
+            ++it;
+            continue;
+        }
+        m_LodTilesToRetire.push_back(std::move(it->second));
+        it = m_LodTiles.erase(it);
+    }
+
+    // Finest first, they are the closest to the camera. Then region by region, so the jobs of a region run together
+    // instead of evicting it in between
+    auto sortKey = [](const glm::ivec3& key) {
+        const glm::ivec2 region = RegionCache::ToRegionCoord(key.x * CHUNK_WIDTH, key.z * CHUNK_WIDTH);
+        return std::make_tuple(key.y, region.y, region.x, key.z, key.x);
+    };
+    std::vector<glm::ivec3> newTiles(wanted.begin(), wanted.end());
+    std::sort(newTiles.begin(), newTiles.end(), [&sortKey](const glm::ivec3& a, const glm::ivec3& b) { return sortKey(a) < sortKey(b); });
+    for (const auto& key : newTiles) {
+        auto tile = std::make_shared<LodTile>(glm::ivec2(key.x, key.z), key.y);
+        m_LodTiles.emplace(key, tile);
+        ThreadPool::Get().Enqueue([tilePtr = std::move(tile), regions = m_Regions, store = m_Store]() { tilePtr->Generate(*regions, store.get()); });
+    }
+}
+
+void ChunkManager::UpdateFarTerrain() {
+    // The coarsest LOD tiles around the far distance make the voxel terrain a square aligned on them
+    const int far = GetFarDistance();
+    const glm::ivec2 min(((m_Center.x - far) >> LOD_MAX_LEVEL) << LOD_MAX_LEVEL, ((m_Center.z - far) >> LOD_MAX_LEVEL) << LOD_MAX_LEVEL);
+    const glm::ivec2 max = glm::ivec2(((m_Center.x + far) >> LOD_MAX_LEVEL) << LOD_MAX_LEVEL, ((m_Center.z + far) >> LOD_MAX_LEVEL) << LOD_MAX_LEVEL) +
+                           LodTile::GetSize(LOD_MAX_LEVEL);
+    const glm::ivec2 center = glm::ivec2(m_Center.x, m_Center.z) * CHUNK_WIDTH + CHUNK_WIDTH / 2;
+    m_FarTerrain.SetCenter(m_Regions->GetNoise(), center, min * CHUNK_WIDTH, max * CHUNK_WIDTH);
+}
+
+void ChunkManager::RetireLodTiles() {
+    std::erase_if(m_LodTilesToRetire, [this](std::shared_ptr<LodTile>& tile) {
+        if (!IsAreaDrawn(tile->GetOrigin(), tile->GetSize())) return false;
+        tile->Unregister();
+        if (tile.use_count() > 1) m_RetiredChunks.push_back(std::move(tile));
+        return true;
+    });
+}
+
+void ChunkManager::CountRingTriangles() {
+    m_RingTriangles.fill(0);
+    for (const auto& [position, chunk] : m_Chunks) {
+        if (chunk->IsRegistered()) m_RingTriangles[0] += chunk->GetNbTriangles();
+    }
+    for (const auto& [key, tile] : m_LodTiles) {
+        if (tile->IsRegistered()) m_RingTriangles[key.y] += tile->GetNbTriangles();
+    }
+    for (const auto& tile : m_LodTilesToRetire) {
+        if (tile->IsRegistered()) m_RingTriangles[tile->GetLevel()] += tile->GetNbTriangles();
+    }
+}
+
+int ChunkManager::GetLodLevel(const glm::ivec3& chunkCoord) const {
+    // Coarsest level whose tile is out of the ring below, as walking down a quadtree from the coarsest tiles
+    if (GetTileDistance(chunkCoord, LOD_MAX_LEVEL) > GetRingDistance(LOD_MAX_LEVEL)) return LOD_NB_LEVELS;
+    for (int level = LOD_MAX_LEVEL; level > 0; level--) {
+        if (GetTileDistance(chunkCoord, level) > GetRingDistance(level - 1)) return level;
+    }
+    return 0;
+}
+
+int ChunkManager::GetTileDistance(const glm::ivec3& chunkCoord, int level) const {
+    const glm::ivec3 origin = ToTileKey(chunkCoord, level);
+    const int last = LodTile::GetSize(level) - 1;
+    const int dx = std::max({origin.x - m_Center.x, m_Center.x - (origin.x + last), 0});
+    const int dz = std::max({origin.z - m_Center.z, m_Center.z - (origin.z + last), 0});
+    return std::max(dx, dz);
+}
+
+bool ChunkManager::IsAreaDrawn(const glm::ivec2& origin, int size) const {
+    for (int z = origin.y; z < origin.y + size; z++) {
+        for (int x = origin.x; x < origin.x + size; x++) {
+            const glm::ivec3 coord(x, 0, z);
+            const int level = GetLodLevel(coord);
+            if (level == LOD_NB_LEVELS) continue;
+
+            const Renderable* renderable = nullptr;
+            if (level == 0) {
+                auto it = m_Chunks.find(coord);
+                if (it != m_Chunks.end()) renderable = it->second.get();
+            } else {
+                auto it = m_LodTiles.find(ToTileKey(coord, level));
+                if (it != m_LodTiles.end()) renderable = it->second.get();
+            }
+            if (renderable == nullptr || !renderable->IsRegistered()) return false;
+        }
+    }
+    return true;
+}
+
+bool ChunkManager::IsLoaded(const std::shared_ptr<Chunk>& chunk) const {
+    if (!chunk) return false;
+    auto it = m_Chunks.find(chunk->GetWorldPosition());
+    return it != m_Chunks.end() && it->second == chunk;
+}
+
+bool ChunkManager::IsLoaded(const std::shared_ptr<LodTile>& tile) const {
+    if (!tile) return false;
+    auto it = m_LodTiles.find(glm::ivec3(tile->GetOrigin().x, tile->GetLevel(), tile->GetOrigin().y));
+    return it != m_LodTiles.end() && it->second == tile;
+}
+
+ChunkArea ChunkManager::GetArea(const std::shared_ptr<Chunk>& center) {
+    ChunkArea area;
+    const glm::ivec3 coord = center->GetWorldPosition();
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            auto it = m_Chunks.find(coord + glm::ivec3(dx, 0, dz));
+            area[(dz + 1) * LIGHT_AREA_SIZE + dx + 1] = it != m_Chunks.end() ? it->second : nullptr;
+        }
+    }
+    return area;
+}
+
+std::array<std::shared_ptr<Chunk>, 4> ChunkManager::GetNeighbors(const ChunkArea& area) {
+    std::array<std::shared_ptr<Chunk>, 4> neighbors;
+    neighbors[X_POS] = area[CHUNK_AREA_CENTER + 1];
+    neighbors[X_NEG] = area[CHUNK_AREA_CENTER - 1];
+    neighbors[Z_POS] = area[CHUNK_AREA_CENTER + LIGHT_AREA_SIZE];
+    neighbors[Z_NEG] = area[CHUNK_AREA_CENTER - LIGHT_AREA_SIZE];
+    return neighbors;
+}
 
 std::array<std::shared_ptr<Chunk>, 4> ChunkManager::GetNeighbors(glm::ivec3 pos) {
     glm::ivec3 finalPos = pos;
@@ -85,15 +393,6 @@ std::array<std::shared_ptr<Chunk>, 4> ChunkManager::GetNeighbors(glm::ivec3 pos)
     return neighbors;
 }
 
-glm::ivec3 ChunkManager::ToChunkCoord(const glm::vec3& worldPosition) {
-    glm::ivec3 chunkCoord;
-    chunkCoord.x = static_cast<int>(worldPosition.x) / CHUNK_WIDTH;
-    chunkCoord.y = 0;
-    chunkCoord.z = static_cast<int>(worldPosition.z) / CHUNK_WIDTH;
-
-    return chunkCoord;
-}
-
 void ChunkManager::OnEvent(const Event& event) {
     if (event.GetType() == EventType::AddNewRenderable) {
         const auto* renderableEvent = dynamic_cast<const AddNewRenderableEvent*>(&event);
@@ -101,12 +400,13 @@ void ChunkManager::OnEvent(const Event& event) {
 
         auto renderable = const_cast<Renderable*>(renderableEvent->GetRenderable());
         if (auto* chunk = dynamic_cast<Chunk*>(renderable)) {
-            m_ChunksToRender.push(chunk);
+            std::lock_guard<std::mutex> lock(m_RenderQueueMutex);
+            m_ChunksToRender.push(chunk->weak_from_this());
+        } else if (auto* tile = dynamic_cast<LodTile*>(renderable)) {
+            std::lock_guard<std::mutex> lock(m_RenderQueueMutex);
+            m_LodTilesToRender.push(tile->weak_from_this());
         }
     }
-    if (event.GetType() == EventType::ChunkDataGenerated) {
-        m_NbChunksWithData++;
-    }
 }
 
 Chunk* ChunkManager::GetChunk(glm::ivec3 pos) const {
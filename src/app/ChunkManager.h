@@ -1,48 +1,113 @@
 #ifndef __CHUNK_MANAGER_H__
 #define __CHUNK_MANAGER_H__
 
-#include <FastNoiseLite.h>
-
 #include <array>
+#include <cmath>
+#include <functional>
 #include <glm/glm.hpp>
 #include <glm/gtx/hash.hpp>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Chunk.h"
+#include "ChunkCache.h"
+#include "FarTerrain.h"
+#include "LightEngine.h"
+#include "LodTile.h"
+#include "Noise.h"
+#include "RegionCache.h"
+#include "RegionStore.h"
 
 class Event;
-class Chunk;
 
 class ChunkManager {
    public:
     ChunkManager();
     ~ChunkManager();
-    void Init();
+    void Init(const std::string& savePath = "");  // No persistence without a save directory
     void Update();
     void LoadChunk(const glm::vec3& position);
-    void UnloadChunk(const glm::vec3& position);
+    void UnloadChunk(const glm::vec3& position);  // The chunk goes cold, see ChunkCache
+
+    // Loads the chunks in the render distance around chunkCoord and unloads the others, when the camera changed chunk.
+    // The LOD tiles of the rings beyond follow, see LodTile
+    void SetCenter(const glm::ivec3& chunkCoord);
+
+    // Block light emitted at a world voxel, 0 removes it. Spread on a worker, the chunks it reaches are remeshed.
+    // Ignored outside of the chunks' height
+    void SetLightSource(const glm::ivec3& worldVoxel, uint8_t level);
 
     std::array<std::shared_ptr<Chunk>, 4> GetNeighbors(glm::ivec3 pos);
-    glm::ivec3 ToChunkCoord(const glm::vec3& worldPosition);
+    static std::array<std::shared_ptr<Chunk>, 4> GetNeighbors(const ChunkArea& area);
+    ChunkArea GetArea(const std::shared_ptr<Chunk>& center);
+    static glm::ivec3 ToChunkCoord(const glm::vec3& worldPosition) {
+        // Floor so that negative positions land in the chunk below instead of chunk 0
+        return glm::ivec3(static_cast<int>(std::floor(worldPosition.x / CHUNK_WIDTH)), 0,
+                          static_cast<int>(std::floor(worldPosition.z / CHUNK_WIDTH)));
+    }
 
     void OnEvent(const Event& event);
 
     /* Getters */
     Chunk* GetChunk(glm::ivec3 pos) const;
     int GetRenderDistance() const { return m_RenderDistance; }
+    int GetCacheDistance() const { return m_RenderDistance + CHUNK_CACHE_MARGIN; }
+    int GetRingDistance(int level) const { return static_cast<int>(m_RenderDistance * LOD_RING_SCALES[level]); }
+    int GetFarDistance() const { return GetRingDistance(LOD_MAX_LEVEL); }  // Chunks drawn up to, at the coarsest level
+    // Level drawing a chunk: 0 when loaded, LOD_NB_LEVELS past the far distance. Every chunk of a tile gets its level
+    int GetLodLevel(const glm::ivec3& chunkCoord) const;
+    size_t GetNbLodTiles() const { return m_LodTiles.size(); }
+    const std::array<size_t, LOD_NB_LEVELS>& GetRingTriangles() const { return m_RingTriangles; }  // Drawn, per level
+    const FarTerrain& GetFarTerrain() const { return m_FarTerrain; }
+    size_t GetNbLoadedChunks() const { return m_Chunks.size(); }
+    const ChunkCache& GetColdChunks() const { return m_ColdChunks; }
+    size_t GetNbLightSources() const { return m_Lighting->GetNbSources(); }
 
     /* Setters */
     void SetRenderDistance(int distance) { m_RenderDistance = distance; }
+    void SetColdBudget(size_t bytes) { m_ColdChunks.SetBudget(bytes); }
 
    private:
+    void LoadMissingChunks();
+    void UpdateLodTiles();
+    void RetireLodTiles();
+    void UpdateFarTerrain();
+    void CountRingTriangles();
+    bool IsLoaded(const std::shared_ptr<Chunk>& chunk) const;
+    bool IsLoaded(const std::shared_ptr<LodTile>& tile) const;
+    bool IsAreaDrawn(const glm::ivec2& origin, int size) const;
+    int GetTileDistance(const glm::ivec3& chunkCoord, int level) const;  // From the center to the closest chunk of the tile
+    static glm::ivec3 ToTileKey(const glm::ivec3& chunkCoord, int level) {
+        return glm::ivec3((chunkCoord.x >> level) << level, level, (chunkCoord.z >> level) << level);
+    }
+
     int m_RenderDistance;
-    FastNoiseLite m_Noise;
+    glm::ivec3 m_Center;  // Chunk the loaded square is centered on
+    std::shared_ptr<RegionCache> m_Regions;  // Owns the terrain noise, generation jobs share it instead of copying it
+    std::shared_ptr<RegionStore> m_Store;    // Saved chunks, nullptr when the world is not persisted
+    std::shared_ptr<LightEngine> m_Lighting;
     std::unordered_map<glm::ivec3, std::shared_ptr<Chunk>> m_Chunks;  // For direct access
+    ChunkCache m_ColdChunks;
+    // Chunks and LOD tiles dropped while a job still holds them, released on the main thread
+    std::vector<std::shared_ptr<Renderable>> m_RetiredChunks;
+    std::unordered_map<glm::ivec3, std::shared_ptr<LodTile>> m_LodTiles;  // Keyed by origin x, level, origin z
+    std::vector<std::shared_ptr<LodTile>> m_LodTilesToRetire;           // Drawn until what replaces them is
+    std::array<size_t, LOD_NB_LEVELS> m_RingTriangles;
+    FarTerrain m_FarTerrain;  // Beyond the LOD rings
 
-    int m_NbChunksWithData;
-    std::queue<Chunk*> m_ChunksToMesh;
-    std::queue<Chunk*> m_ChunksToRender;
+    // Weak references, chunks unloaded before reaching the front are skipped
+    std::queue<std::weak_ptr<Chunk>> m_ChunksToMesh;
+    std::mutex m_RenderQueueMutex;  // Meshing jobs push, the main thread pops
+    std::queue<std::weak_ptr<Chunk>> m_ChunksToRender;
+    std::queue<std::weak_ptr<LodTile>> m_LodTilesToRender;
+    std::unordered_set<Chunk*> m_ChunksMeshing;           // Mesh job enqueued, not committed yet
+    std::vector<std::weak_ptr<Chunk>> m_ChunksToRelight;  // Light changed after meshing, see LightEngine::TakeDirtyChunks
+    std::function<void(const Event&)> m_EventListener;    // Kept to unsubscribe it
 };
 
 #endif  // __CHUNK_MANAGER_H__
\ No newline at end of file
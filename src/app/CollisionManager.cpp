@@ -1,82 +1,94 @@
 #include "CollisionManager.h"
 
-#include "Entity.h"
+#include "EntityStore.h"
 #include "Voxel.h"
-#include "World.h"
-#include "events/EventApplication.h"
-#include "events/EventDispatcher.h"
+#include "VoxelGrid.h"
 #include "pch.h"
 
-CollisionManager::CollisionManager(const World& world) : m_Enable(true), m_World(world) {}
+CollisionManager::CollisionManager(const VoxelGrid& grid) : m_Enable(true), m_Grid(grid) {}
 
-void CollisionManager::Update() {
+void CollisionManager::Sweep(EntityStore& store, size_t index, float dt, std::vector<Box>& candidates) const {
+    glm::vec3& velocity = store.GetVelocities()[index];
+    glm::vec3 delta = velocity * dt;
+
+    int blocked = Move(store, index, delta, candidates);
     if (!m_Enable) return;
-    for (auto& entity : Entity::GetEntities()) {
-        auto entityPos = entity->GetPosition();
-        auto entityBox = entity->GetBoundingBox();
-
-        // Convert player position to voxel coordinates [3*3*3]
-        int minX = std::floor(entityPos.x) - 2;
-        int maxX = std::ceil(entityPos.x) + 2;
-        int minY = std::floor(entityPos.y) - 2;
-        int maxY = std::ceil(entityPos.y) + 2;
-        int minZ = std::floor(entityPos.z) - 2;
-        int maxZ = std::ceil(entityPos.z) + 2;
-
-        entity->SetGrounded(false);
-
-        for (int x = minX; x < maxX; x++) {
-            for (int y = minY; y < maxY; y++) {
-                for (int z = minZ; z < maxZ; z++) {
-                    Voxel* voxel = m_World.GetVoxel(glm::vec3(x, y, z));
-                    if (voxel && !voxel->IsTransparent()) {
-                        Box other = voxel->GetBoundingBox();
-                        if (entityBox.Intersects(other)) {
-                            ResolveCollision(*entity, other);
-                        }
-                    }
+
+    store.GetGrounded()[index] = (blocked & (1 << 1)) && delta.y < 0.0f;
+    for (int axis = 0; axis < 3; axis++) {
+        if (blocked & (1 << axis)) velocity[axis] = 0.0f;
+    }
+}
+
+int CollisionManager::Move(EntityStore& store, size_t index, const glm::vec3& delta, std::vector<Box>& candidates) const {
+    glm::vec3& position = store.GetPositions()[index];
+    Box& entityBox = store.GetBoxes()[index];
+
+    if (!m_Enable) {  // No collision, move freely
+        position += delta;
+        entityBox.Move(delta);
+        return 0;
+    }
+
+    // Gather every solid voxel the entity may touch along its whole path, once per step
+    Box sweptBox = entityBox;
+    sweptBox.Expand(delta);
+    GatherCandidates(sweptBox, candidates);
+
+    // Resolve one axis at a time, Y first so the entity lands before sliding along walls
+    int blocked = 0;
+    constexpr std::array<int, 3> axisOrder = {1, 0, 2};
+    for (int axis : axisOrder) {
+        if (delta[axis] == 0.0f) continue;
+
+        float clipped = delta[axis];
+        for (const auto& other : candidates) {
+            clipped = ClipAxis(entityBox, other, axis, clipped);
+        }
+        if (clipped != delta[axis]) blocked |= 1 << axis;
+
+        glm::vec3 move(0.0f);
+        move[axis] = clipped;
+        position += move;
+        entityBox.Move(move);
+    }
+    return blocked;
+}
+
+void CollisionManager::GatherCandidates(const Box& sweptBox, std::vector<Box>& candidates) const {
+    candidates.clear();
+
+    int minX = static_cast<int>(std::floor(sweptBox.min.x));
+    int maxX = static_cast<int>(std::floor(sweptBox.max.x));
+    int minY = std::max(static_cast<int>(std::floor(sweptBox.min.y)), 0);
+    int maxY = static_cast<int>(std::floor(sweptBox.max.y));
+    int minZ = static_cast<int>(std::floor(sweptBox.min.z));
+    int maxZ = static_cast<int>(std::floor(sweptBox.max.z));
+
+    for (int x = minX; x <= maxX; x++) {
+        for (int z = minZ; z <= maxZ; z++) {
+            for (int y = minY; y <= maxY; y++) {
+                glm::vec3 voxelPos(x, y, z);
+                Voxel* voxel = m_Grid.GetVoxel(voxelPos);
+                if (voxel && !voxel->IsTransparent()) {
+                    candidates.push_back(Box(voxelPos, glm::vec3(1.0f)));
                 }
             }
         }
     }
 }
 
-void CollisionManager::ResolveCollision(Entity& entity, const Box& other) {
-    const auto& entityBox = entity.GetBoundingBox();
-    glm::vec3 velocity = entity.GetVelocityVector();
-
-    float RightPenetration = other.max.x - entityBox.min.x;
-    float LeftPenetration = entityBox.max.x - other.min.x;
-    float TopPenetration = other.max.y - entityBox.min.y;
-    float BottomPenetration = entityBox.max.y - other.min.y;
-    float FrontPenetration = other.max.z - entityBox.min.z;
-    float BackPenetration = entityBox.max.z - other.min.z;
-
-    float minPene = std::min({RightPenetration, LeftPenetration, TopPenetration, BottomPenetration, FrontPenetration, BackPenetration});
-
-    glm::vec3 correction(0.0f);
-
-    if (minPene == RightPenetration) {
-        correction.x = RightPenetration;
-        velocity.x = 0.0f;
-    } else if (minPene == LeftPenetration) {
-        correction.x = -LeftPenetration;
-        velocity.x = 0.0f;
-    } else if (minPene == TopPenetration) {
-        correction.y = TopPenetration;
-        velocity.y = 0.0f;
-        entity.SetGrounded(true);
-    } else if (minPene == BottomPenetration) {
-        correction.y = -BottomPenetration;
-        velocity.y = 0.0f;
-    } else if (minPene == FrontPenetration) {
-        correction.z = FrontPenetration;
-        velocity.z = 0.0f;
-    } else if (minPene == BackPenetration) {
-        correction.z = -BackPenetration;
-        velocity.z = 0.0f;
+float CollisionManager::ClipAxis(const Box& entityBox, const Box& other, int axis, float delta) {
+    // Only boxes overlapping on the two other axes can block the movement
+    for (int i = 0; i < 3; i++) {
+        if (i == axis) continue;
+        if (entityBox.max[i] <= other.min[i] || entityBox.min[i] >= other.max[i]) return delta;
     }
 
-    entity.Move(correction);
-    entity.SetVelocity(velocity);
+    if (delta > 0.0f && entityBox.max[axis] <= other.min[axis]) {
+        delta = std::min(delta, other.min[axis] - entityBox.max[axis]);
+    } else if (delta < 0.0f && entityBox.min[axis] >= other.max[axis]) {
+        delta = std::max(delta, other.max[axis] - entityBox.min[axis]);
+    }
+    return delta;
 }
@@ -1,25 +1,35 @@
 #ifndef __COLLISION_MANAGER_H__
 #define __COLLISION_MANAGER_H__
 
+#include <vector>
+
 #include "utils/Box.h"
 
-class Entity;
 class Box;
-class World;
+class EntityStore;
+class VoxelGrid;
 
 class CollisionManager {
    public:
-    CollisionManager(const World& world);
+    CollisionManager(const VoxelGrid& grid);
+
+    // Move one entity of the store by its velocity, stopping at solid voxels. Safe to call from several threads
+    // as long as each caller owns its candidates buffer
+    void Sweep(EntityStore& store, size_t index, float dt, std::vector<Box>& candidates) const;
+    // Move one entity of the store by delta, stopping at solid voxels, without touching its velocity.
+    // Returns a bit mask of the blocked axes (1 << axis)
+    int Move(EntityStore& store, size_t index, const glm::vec3& delta, std::vector<Box>& candidates) const;
 
-    void Update();
     void Enable() { m_Enable = true; }
     void Disable() { m_Enable = false; }
 
    private:
     bool m_Enable;
-    const World& m_World;
+    const VoxelGrid& m_Grid;
+
+    void GatherCandidates(const Box& sweptBox, std::vector<Box>& candidates) const;
 
-    void ResolveCollision(Entity& entity, const Box& other);
+    static float ClipAxis(const Box& entityBox, const Box& other, int axis, float delta);
 };
 
-#endif  // __COLLISION_MANAGER_H__
\ No newline at end of file
+#endif  // __COLLISION_MANAGER_H__
@@ -2,21 +2,16 @@
 
 #include "utils/Time.h"
 
-std::unordered_set<Entity*> Entity::m_Entities;
+Entity::Entity(EntityStore& store, const glm::vec3& boxsize, const glm::vec3& boxoffet)
+    : m_Store(store), m_ID(store.Create(boxsize, boxoffet, glm::vec3(0.0f), GRAVITY)) {}
 
-Entity::Entity(const glm::vec3& boxsize, const glm::vec3& boxoffet)
-    : m_Position(glm::vec3(0.0f)), m_Velocity(glm::vec3(0.0f)), m_BoundingBox(glm::vec3(0.0f) - boxoffet, boxsize), m_Grounded(false) {
-    m_Entities.insert(this);
-}
-
-Entity::Entity(const glm::vec3& boxsize, const glm::vec3& boxoffet, const glm::vec3& position)
-    : m_Position(position), m_Velocity(glm::vec3(0.0f)), m_BoundingBox(position - boxoffet, boxsize), m_Grounded(false) {
-    m_Entities.insert(this);
-}
+Entity::Entity(EntityStore& store, const glm::vec3& boxsize, const glm::vec3& boxoffet, const glm::vec3& position)
+    : m_Store(store), m_ID(store.Create(boxsize, boxoffet, position, GRAVITY)) {}
 
-Entity::~Entity() { m_Entities.erase(this); }
+Entity::~Entity() { m_Store.Destroy(m_ID); }
 
 void Entity::Move(const glm::vec3& delta) {
-    m_Position += delta;
-    m_BoundingBox.Move(delta);
+    size_t index = Index();
+    m_Store.GetPositions()[index] += delta;
+    m_Store.GetBoxes()[index].Move(delta);
 }
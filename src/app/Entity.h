@@ -3,45 +3,45 @@
 
 #include <glm/glm.hpp>
 #include <memory>
-#include <unordered_set>
 
+#include "EntityStore.h"
 #include "utils/Box.h"
 #include "utils/Time.h"
 
 constexpr int PHYSICS_RATE = 120;
 constexpr float PHYSICS_STEP = 1.0f / PHYSICS_RATE;
+constexpr float GRAVITY = 40.0f;
 
+// Object facade over an entity stored in an EntityStore, the physics state itself lives in the store arrays
 class Entity {
    public:
-    Entity(const glm::vec3& boxsize, const glm::vec3& boxoffet);
-    Entity(const glm::vec3& boxsize, const glm::vec3& boxoffet, const glm::vec3& position);
+    Entity(EntityStore& store, const glm::vec3& boxsize, const glm::vec3& boxoffet);
+    Entity(EntityStore& store, const glm::vec3& boxsize, const glm::vec3& boxoffet, const glm::vec3& position);
+    Entity(const Entity&) = delete;
+    Entity& operator=(const Entity&) = delete;
     virtual ~Entity();
 
     virtual void Update(float dt = Time::Get().GetDeltaTime()) = 0;
-    virtual void Move(const glm::vec3& delta);
+    void Move(const glm::vec3& delta);
 
     /* Getters */
-    Box GetBoundingBox() const { return m_BoundingBox; }
-    glm::vec3 GetVelocityVector() const { return m_Velocity; }
-    glm::vec3 GetPosition() const { return m_Position; }
-    bool Grounded() const { return m_Grounded; }
-
-    static std::unordered_set<Entity*> GetEntities() { return m_Entities; }
+    EntityID GetID() const { return m_ID; }
+    const Box& GetBoundingBox() const { return m_Store.GetBoxes()[Index()]; }
+    glm::vec3 GetVelocityVector() const { return m_Store.GetVelocities()[Index()]; }
+    glm::vec3 GetPosition() const { return m_Store.GetPositions()[Index()]; }
+    bool Grounded() const { return m_Store.GetGrounded()[Index()]; }
 
     /* Setters */
-    void SetBoundingBox(const Box& box) { m_BoundingBox = box; }
-    void SetVelocity(const glm::vec3& velocity) { m_Velocity = velocity; }
-    virtual void SetPosition(const glm::vec3& position) { m_Position = position; }
-    void SetGrounded(bool grounded) { m_Grounded = grounded; }
+    void SetVelocity(const glm::vec3& velocity) { m_Store.GetVelocities()[Index()] = velocity; }
+    void SetPosition(const glm::vec3& position) { Move(position - GetPosition()); }
+    void SetGrounded(bool grounded) { m_Store.GetGrounded()[Index()] = grounded; }
+    void SetGravity(float gravity) { m_Store.GetGravities()[Index()] = gravity; }
 
    protected:
-    Box m_BoundingBox;
-    glm::vec3 m_Velocity;
-    glm::vec3 m_Position;
-    bool m_Grounded;
+    EntityStore& m_Store;
+    EntityID m_ID;
 
-   private:
-    static std::unordered_set<Entity*> m_Entities;
+    size_t Index() const { return m_Store.GetIndex(m_ID); }
 };
 
-#endif  // __ENTITY_H__
\ No newline at end of file
+#endif  // __ENTITY_H__
@@ -0,0 +1,107 @@
+#include "EntityBroadphase.h"
+
+#include "ChunkManager.h"
+#include "pch.h"
+
+void EntityBroadphase::Update(const EntityStore& store) {
+    const auto& ids = store.GetIDs();
+    const auto& boxes = store.GetBoxes();
+
+    // Drop the entities destroyed since the last update
+    for (EntityID id = 0; id < m_Tracked.size(); id++) {
+        if (m_Tracked[id] && !store.IsAlive(id)) Remove(id);
+    }
+
+    m_MaxWidth = 0.0f;
+    for (size_t i = 0; i < ids.size(); i++) {
+        EntityID id = ids[i];
+        glm::ivec3 cell = ChunkManager::ToChunkCoord((boxes[i].min + boxes[i].max) * 0.5f);
+        m_MaxWidth = std::max(m_MaxWidth, boxes[i].max.x - boxes[i].min.x);
+
+        if (id >= m_Tracked.size()) {
+            m_Tracked.resize(id + 1, false);
+            m_EntityCells.resize(id + 1);
+            m_CellSlots.resize(id + 1);
+        }
+
+        if (!m_Tracked[id]) {
+            Insert(id, cell);
+        } else if (m_EntityCells[id] != cell) {
+            Remove(id);
+            Insert(id, cell);
+        }
+
+        auto& entry = m_Cells[cell][m_CellSlots[id]];
+        entry.minX = boxes[i].min.x;
+        entry.maxX = boxes[i].max.x;
+    }
+
+    // Entities barely move between two steps, an insertion sort on the nearly sorted cells is close to linear
+    for (auto& [cell, entries] : m_Cells) {
+        for (size_t i = 1; i < entries.size(); i++) {
+            Entry entry = entries[i];
+            size_t j = i;
+            for (; j > 0 && entries[j - 1].minX > entry.minX; j--) {
+                entries[j] = entries[j - 1];
+            }
+            entries[j] = entry;
+        }
+        for (size_t i = 0; i < entries.size(); i++) {
+            m_CellSlots[entries[i].id] = static_cast<uint32_t>(i);
+        }
+    }
+}
+
+void EntityBroadphase::FindPairs(std::vector<EntityPair>& pairs) const {
+    // Half of the neighbourhood, so that each couple of cells is visited once
+    constexpr std::array<glm::ivec3, 4> neighborOffsets = {glm::ivec3(1, 0, 0), glm::ivec3(1, 0, 1), glm::ivec3(0, 0, 1), glm::ivec3(-1, 0, 1)};
+
+    pairs.clear();
+    for (const auto& [cell, entries] : m_Cells) {
+        // Sweep inside the cell, the list is sorted so stop as soon as the X extents stop overlapping
+        for (size_t a = 0; a < entries.size(); a++) {
+            for (size_t b = a + 1; b < entries.size() && entries[b].minX <= entries[a].maxX; b++) {
+                pairs.emplace_back(entries[a].id, entries[b].id);
+            }
+        }
+
+        for (const auto& offset : neighborOffsets) {
+            auto it = m_Cells.find(cell + offset);
+            if (it != m_Cells.end()) PairCells(entries, it->second, m_MaxWidth, pairs);
+        }
+    }
+}
+
+void EntityBroadphase::PairCells(const std::vector<Entry>& cellA, const std::vector<Entry>& cellB, float maxWidth,
+                                 std::vector<EntityPair>& pairs) {
+    auto byMinX = [](const Entry& entry, float x) { return entry.minX < x; };
+    for (const auto& a : cellA) {
+        // No box of cellB starting before a.minX - maxWidth can reach a
+        auto it = std::lower_bound(cellB.begin(), cellB.end(), a.minX - maxWidth, byMinX);
+        for (; it != cellB.end() && it->minX <= a.maxX; ++it) {
+            if (it->maxX >= a.minX) pairs.emplace_back(a.id, it->id);
+        }
+    }
+}
+
+void EntityBroadphase::Insert(EntityID id, const glm::ivec3& cell) {
+    auto& entries = m_Cells[cell];
+    m_EntityCells[id] = cell;
+    m_CellSlots[id] = static_cast<uint32_t>(entries.size());
+    m_Tracked[id] = true;
+    entries.push_back({id, 0.0f, 0.0f});
+}
+
+void EntityBroadphase::Remove(EntityID id) {
+    auto it = m_Cells.find(m_EntityCells[id]);
+    auto& entries = it->second;
+
+    // Swap the last entity of the cell into the hole, the next sort restores the order
+    uint32_t slot = m_CellSlots[id];
+    entries[slot] = entries.back();
+    m_CellSlots[entries[slot].id] = slot;
+    entries.pop_back();
+    if (entries.empty()) m_Cells.erase(it);
+
+    m_Tracked[id] = false;
+}
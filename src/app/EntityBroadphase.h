@@ -0,0 +1,48 @@
+#ifndef __ENTITY_BROADPHASE_H__
+#define __ENTITY_BROADPHASE_H__
+
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "EntityStore.h"
+
+using EntityPair = std::pair<EntityID, EntityID>;
+
+// Uniform grid of entities, one cell per chunk column. Entities are bucketed by the center of their box,
+// so two overlapping entities always sit in the same or in neighbouring cells. Each cell is kept sorted
+// along X so only entities whose X extents overlap are paired.
+class EntityBroadphase {
+   public:
+    EntityBroadphase() : m_MaxWidth(0.0f) {}
+
+    // Move the entities that changed cell since the last call and drop the destroyed ones
+    void Update(const EntityStore& store);
+    // Fill pairs with every couple of entities close enough to overlap
+    void FindPairs(std::vector<EntityPair>& pairs) const;
+
+    /* Getters */
+    size_t GetNbCells() const { return m_Cells.size(); }
+
+   private:
+    struct Entry {
+        EntityID id;
+        float minX, maxX;
+    };
+
+    std::unordered_map<glm::ivec3, std::vector<Entry>> m_Cells;
+    float m_MaxWidth;  // Widest box along X, bounds the search in neighbouring cells
+
+    // Indexed by EntityID
+    std::vector<glm::ivec3> m_EntityCells;
+    std::vector<uint32_t> m_CellSlots;  // Position of the entity in its cell vector
+    std::vector<uint8_t> m_Tracked;
+
+    void Insert(EntityID id, const glm::ivec3& cell);
+    void Remove(EntityID id);
+    static void PairCells(const std::vector<Entry>& cellA, const std::vector<Entry>& cellB, float maxWidth, std::vector<EntityPair>& pairs);
+};
+
+#endif  // __ENTITY_BROADPHASE_H__
@@ -0,0 +1,72 @@
+#include "EntityStore.h"
+
+#include "pch.h"
+
+EntityID EntityStore::Create(const glm::vec3& boxsize, const glm::vec3& boxoffset, const glm::vec3& position, float gravity) {
+    EntityID id;
+    if (!m_FreeIDs.empty()) {
+        id = m_FreeIDs.back();
+        m_FreeIDs.pop_back();
+    } else {
+        id = static_cast<EntityID>(m_Sparse.size());
+        m_Sparse.push_back(INVALID_ENTITY);
+    }
+
+    m_Sparse[id] = static_cast<EntityID>(m_IDs.size());
+    m_IDs.push_back(id);
+    m_Positions.push_back(position);
+    m_Velocities.push_back(glm::vec3(0.0f));
+    m_Boxes.push_back(Box(position - boxoffset, boxsize));
+    m_Grounded.push_back(false);
+    m_Gravities.push_back(gravity);
+
+    return id;
+}
+
+void EntityStore::Destroy(EntityID id) {
+    if (!IsAlive(id)) return;
+
+    // Swap the last entity into the hole to keep the arrays packed
+    size_t index = m_Sparse[id];
+    size_t last = m_IDs.size() - 1;
+    if (index != last) {
+        m_Positions[index] = m_Positions[last];
+        m_Velocities[index] = m_Velocities[last];
+        m_Boxes[index] = m_Boxes[last];
+        m_Grounded[index] = m_Grounded[last];
+        m_Gravities[index] = m_Gravities[last];
+        m_IDs[index] = m_IDs[last];
+        m_Sparse[m_IDs[index]] = static_cast<EntityID>(index);
+    }
+
+    m_Positions.pop_back();
+    m_Velocities.pop_back();
+    m_Boxes.pop_back();
+    m_Grounded.pop_back();
+    m_Gravities.pop_back();
+    m_IDs.pop_back();
+
+    m_Sparse[id] = INVALID_ENTITY;
+    m_FreeIDs.push_back(id);
+}
+
+void EntityStore::Clear() {
+    m_Positions.clear();
+    m_Velocities.clear();
+    m_Boxes.clear();
+    m_Grounded.clear();
+    m_Gravities.clear();
+    m_IDs.clear();
+    m_Sparse.clear();
+    m_FreeIDs.clear();
+}
+
+void EntityStore::Reserve(size_t count) {
+    m_Positions.reserve(count);
+    m_Velocities.reserve(count);
+    m_Boxes.reserve(count);
+    m_Grounded.reserve(count);
+    m_Gravities.reserve(count);
+    m_IDs.reserve(count);
+    m_Sparse.reserve(count);
+}
@@ -0,0 +1,54 @@
+#ifndef __ENTITY_STORE_H__
+#define __ENTITY_STORE_H__
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <limits>
+#include <vector>
+
+#include "utils/Box.h"
+
+using EntityID = uint32_t;
+constexpr EntityID INVALID_ENTITY = std::numeric_limits<EntityID>::max();
+
+// Structure of arrays holding the physics state of every entity.
+// Components are packed in dense arrays, an EntityID stays valid while other entities are created or destroyed.
+class EntityStore {
+   public:
+    EntityStore() = default;
+
+    EntityID Create(const glm::vec3& boxsize, const glm::vec3& boxoffset, const glm::vec3& position, float gravity);
+    void Destroy(EntityID id);
+    void Clear();
+
+    bool IsAlive(EntityID id) const { return id < m_Sparse.size() && m_Sparse[id] != INVALID_ENTITY; }
+    size_t GetIndex(EntityID id) const { return m_Sparse[id]; }
+    size_t GetSize() const { return m_IDs.size(); }
+    void Reserve(size_t count);
+
+    /* Component arrays, indexed by dense index */
+    std::vector<glm::vec3>& GetPositions() { return m_Positions; }
+    std::vector<glm::vec3>& GetVelocities() { return m_Velocities; }
+    std::vector<Box>& GetBoxes() { return m_Boxes; }
+    std::vector<uint8_t>& GetGrounded() { return m_Grounded; }
+    std::vector<float>& GetGravities() { return m_Gravities; }
+    const std::vector<glm::vec3>& GetPositions() const { return m_Positions; }
+    const std::vector<glm::vec3>& GetVelocities() const { return m_Velocities; }
+    const std::vector<Box>& GetBoxes() const { return m_Boxes; }
+    const std::vector<uint8_t>& GetGrounded() const { return m_Grounded; }
+    const std::vector<float>& GetGravities() const { return m_Gravities; }
+    const std::vector<EntityID>& GetIDs() const { return m_IDs; }
+
+   private:
+    std::vector<glm::vec3> m_Positions;
+    std::vector<glm::vec3> m_Velocities;
+    std::vector<Box> m_Boxes;
+    std::vector<uint8_t> m_Grounded;  // Not a vector<bool>, workers write neighbouring entries concurrently
+    std::vector<float> m_Gravities;
+
+    std::vector<EntityID> m_IDs;       // Dense index -> ID
+    std::vector<EntityID> m_Sparse;    // ID -> dense index
+    std::vector<EntityID> m_FreeIDs;   // IDs available for reuse
+};
+
+#endif  // __ENTITY_STORE_H__
@@ -0,0 +1,126 @@
+#include "FarTerrain.h"
+
+#include "Chunk.h"
+#include "Noise.h"
+#include "pch.h"
+#include "utils/Profiler.h"
+
+constexpr float FAR_TERRAIN_SIDE_SHADE = 0.8f;  // Shading of a vertical slope, a flat one gets the top face shading of 1
+
+/* FarTerrainLevel */
+FarTerrainLevel::FarTerrainLevel(int level) : Renderable(glm::vec3(0.0f), 1), m_Spacing(FAR_TERRAIN_SPACING << level), m_Center(0), m_NbSamples(0) {
+    m_ShaderName = "gbuffer_terrain";
+}
+
+FarTerrainLevel::~FarTerrainLevel() { Unregister(); }
+
+bool FarTerrainLevel::SetCenter(const Noise& noise, const glm::ivec2& center) {
+    // Snapped to the closest grid point, floored so negative coordinates snap the same way
+    auto snap = [this](int coord) { return static_cast<int>(std::floor((coord + m_Spacing / 2) / static_cast<float>(m_Spacing))) * m_Spacing; };
+    const glm::ivec2 snapped(snap(center.x), snap(center.y));
+    if (!m_Heights.empty() && snapped == m_Center) return false;
+
+    const bool hadHeights = !m_Heights.empty();
+    const glm::ivec2 oldMin = GetMin();
+    m_Center = snapped;
+    const glm::ivec2 min = GetMin();
+    const glm::ivec2 shift = (min - oldMin) / m_Spacing;
+
+    std::vector<float> heights(FAR_TERRAIN_NB_POINTS * FAR_TERRAIN_NB_POINTS);
+    for (int z = 0; z < FAR_TERRAIN_NB_POINTS; z++) {
+        for (int x = 0; x < FAR_TERRAIN_NB_POINTS; x++) {
+            const int oldX = x + shift.x;
+            const int oldZ = z + shift.y;
+            if (hadHeights && oldX >= 0 && oldX < FAR_TERRAIN_NB_POINTS && oldZ >= 0 && oldZ < FAR_TERRAIN_NB_POINTS) {
+                heights[z * FAR_TERRAIN_NB_POINTS + x] = GetHeight(oldX, oldZ);
+                continue;
+            }
+
+            // Top of the column the chunks would generate there
+            const float noiseValue = noise.GetNoise(static_cast<float>(min.x + x * m_Spacing), static_cast<float>(min.y + z * m_Spacing));
+            const int height = std::min(Chunk::ToColumnHeight(noiseValue), CHUNK_HEIGHT - 1) + 1;
+            heights[z * FAR_TERRAIN_NB_POINTS + x] = static_cast<float>(height) - FAR_TERRAIN_SINK;
+            m_NbSamples++;
+        }
+    }
+    m_Heights.swap(heights);
+    return true;
+}
+
+void FarTerrainLevel::GenerateMesh(const glm::ivec2& innerMin, const glm::ivec2& innerMax) {
+    PROFILE_SCOPE("FarTerrainLevel::GenerateMesh");
+
+    const glm::ivec2 min = GetMin();
+    m_Position = glm::vec3(min.x, 0.0f, min.y);  // Vertices relative to the corner, the model matrix moves them
+    m_BackMesh.vertices.reserve(FAR_TERRAIN_NB_POINTS * FAR_TERRAIN_NB_POINTS * CHUNK_VERTEX_SIZE);
+
+    for (int z = 0; z < FAR_TERRAIN_NB_POINTS; z++) {
+        for (int x = 0; x < FAR_TERRAIN_NB_POINTS; x++) {
+            const float dx = GetHeight(std::min(x + 1, FAR_TERRAIN_NB_POINTS - 1), z) - GetHeight(std::max(x - 1, 0), z);
+            const float dz = GetHeight(x, std::min(z + 1, FAR_TERRAIN_NB_POINTS - 1)) - GetHeight(x, std::max(z - 1, 0));
+            const glm::vec3 normal = glm::normalize(glm::vec3(-dx, 2.0f * m_Spacing, -dz));
+            const float shade = FAR_TERRAIN_SIDE_SHADE + (1.0f - FAR_TERRAIN_SIDE_SHADE) * normal.y;
+
+            const float vertex[CHUNK_VERTEX_SIZE] = {static_cast<float>(x * m_Spacing), GetHeight(x, z), static_cast<float>(z * m_Spacing), shade, 1.0f};
+            m_BackMesh.vertices.insert(m_BackMesh.vertices.end(), std::begin(vertex), std::end(vertex));
+        }
+    }
+
+    // A cell inside the inner square by at least one spacing is drawn by the finer terrain
+    auto isHidden = [&](int x, int z) {
+        const glm::ivec2 cellMin = min + glm::ivec2(x, z) * m_Spacing;
+        const glm::ivec2 cellMax = cellMin + m_Spacing;
+        return cellMin.x >= innerMin.x + m_Spacing && cellMin.y >= innerMin.y + m_Spacing && cellMax.x <= innerMax.x - m_Spacing &&
+               cellMax.y <= innerMax.y - m_Spacing;
+    };
+    for (int z = 0; z < FAR_TERRAIN_NB_POINTS - 1; z++) {
+        for (int x = 0; x < FAR_TERRAIN_NB_POINTS - 1; x++) {
+            if (isHidden(x, z)) continue;
+
+            const uint32_t index = z * FAR_TERRAIN_NB_POINTS + x;
+            const uint32_t below = index + FAR_TERRAIN_NB_POINTS;
+            m_BackMesh.indices.insert(m_BackMesh.indices.end(), {index, below, below + 1, index, below + 1, index + 1});
+        }
+    }
+
+    CommitMesh();
+}
+
+void FarTerrainLevel::Update() {}
+
+/* FarTerrain */
+FarTerrain::FarTerrain() {
+    for (int level = 0; level < FAR_TERRAIN_NB_LEVELS; level++) {
+        m_Levels[level] = std::make_unique<FarTerrainLevel>(level);
+        m_InnerSquares[level] = glm::ivec4(0);
+    }
+}
+
+void FarTerrain::SetCenter(const Noise& noise, const glm::ivec2& center, const glm::ivec2& innerMin, const glm::ivec2& innerMax) {
+    PROFILE_SCOPE("FarTerrain::SetCenter");
+
+    // Each level is a ring around the one below it, the finest around the voxel terrain
+    glm::ivec4 inner(innerMin.x, innerMin.y, innerMax.x, innerMax.y);
+    for (int level = 0; level < FAR_TERRAIN_NB_LEVELS; level++) {
+        FarTerrainLevel& terrain = *m_Levels[level];
+        const bool moved = terrain.SetCenter(noise, center);
+        if (moved || inner != m_InnerSquares[level]) {
+            terrain.GenerateMesh(glm::ivec2(inner.x, inner.y), glm::ivec2(inner.z, inner.w));
+            terrain.Register();
+            m_InnerSquares[level] = inner;
+        }
+        inner = glm::ivec4(terrain.GetMin().x, terrain.GetMin().y, terrain.GetMax().x, terrain.GetMax().y);
+    }
+}
+
+size_t FarTerrain::GetNbTriangles() const {
+    size_t nbTriangles = 0;
+    for (const auto& level : m_Levels) nbTriangles += level->GetNbTriangles();
+    return nbTriangles;
+}
+
+size_t FarTerrain::GetNbSamples() const {
+    size_t nbSamples = 0;
+    for (const auto& level : m_Levels) nbSamples += level->GetNbSamples();
+    return nbSamples;
+}
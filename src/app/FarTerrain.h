@@ -0,0 +1,69 @@
+#ifndef __FAR_TERRAIN_H__
+#define __FAR_TERRAIN_H__
+
+#include <array>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+#include "gfx/Renderable.h"
+
+class Noise;
+
+constexpr int FAR_TERRAIN_NB_LEVELS = 3;
+constexpr int FAR_TERRAIN_HALF_CELLS = 64;                             // Cells from the center of a level to its edge
+constexpr int FAR_TERRAIN_NB_POINTS = 2 * FAR_TERRAIN_HALF_CELLS + 1;  // Heights per side of a level
+constexpr int FAR_TERRAIN_SPACING = 32;                                // Voxels between the heights of the finest level, each level doubles it
+constexpr float FAR_TERRAIN_SINK = 4.0f;  // Voxels the heightmap is lowered by, it overlaps the voxel terrain at its inner edge
+
+// One level of the clipmap: heights sampled on a grid around a center snapped to the spacing, meshed as a ring around
+// the inner square drawn by finer terrain. Heights are kept between moves, only the rows and columns uncovered are
+// sampled again.
+class FarTerrainLevel : public Renderable {
+   public:
+    FarTerrainLevel(int level);
+    ~FarTerrainLevel();
+
+    // Main thread. Returns whether the grid moved
+    bool SetCenter(const Noise& noise, const glm::ivec2& center);
+    // Cells fully inside the inner square are left out, the cells on its edge are kept so the levels overlap
+    void GenerateMesh(const glm::ivec2& innerMin, const glm::ivec2& innerMax);
+    void Update() override;
+
+    /* Getters */
+    int GetSpacing() const { return m_Spacing; }
+    glm::ivec2 GetMin() const { return m_Center - FAR_TERRAIN_HALF_CELLS * m_Spacing; }  // World x/z of the grid corners
+    glm::ivec2 GetMax() const { return m_Center + FAR_TERRAIN_HALF_CELLS * m_Spacing; }
+    size_t GetNbSamples() const { return m_NbSamples; }
+
+   private:
+    float GetHeight(int x, int z) const { return m_Heights[z * FAR_TERRAIN_NB_POINTS + x]; }
+
+    int m_Spacing;
+    glm::ivec2 m_Center;
+    std::vector<float> m_Heights;  // Surface height of each grid point, empty before the first SetCenter
+    size_t m_NbSamples;            // Noise samples taken since the start
+};
+
+// Heightmap clipmap drawn beyond the LOD rings, from the same noise and column heights as the chunks. Owned by the
+// ChunkManager, which recenters it with the loaded square.
+class FarTerrain {
+   public:
+    FarTerrain();
+
+    // World x/z of the camera, innerMin/innerMax the world x/z square the voxel terrain draws. Levels whose grid or
+    // inner square moved are remeshed and registered again
+    void SetCenter(const Noise& noise, const glm::ivec2& center, const glm::ivec2& innerMin, const glm::ivec2& innerMax);
+
+    /* Getters */
+    int GetExtent() const { return FAR_TERRAIN_HALF_CELLS * (FAR_TERRAIN_SPACING << (FAR_TERRAIN_NB_LEVELS - 1)); }  // Voxels from the center
+    size_t GetNbTriangles() const;
+    size_t GetNbSamples() const;
+
+   private:
+    std::array<std::unique_ptr<FarTerrainLevel>, FAR_TERRAIN_NB_LEVELS> m_Levels;
+    std::array<glm::ivec4, FAR_TERRAIN_NB_LEVELS> m_InnerSquares;  // Last meshed inner square of each level, min x/z then max x/z
+};
+
+#endif  // __FAR_TERRAIN_H__
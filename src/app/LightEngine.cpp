@@ -0,0 +1,279 @@
+#include "LightEngine.h"
+
+#include "pch.h"
+#include "utils/Profiler.h"
+
+constexpr int AREA_WIDTH = LIGHT_AREA_SIZE * CHUNK_WIDTH;  // Voxels per area side
+constexpr int SUN_SHIFT = 4;                               // Channels in a light byte
+constexpr int BLOCK_SHIFT = 0;
+
+constexpr int DIRECTIONS[6][3] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+
+// The area as one update sees it: the lit chunks only, voxels addressed from the -X/-Z corner of the -X/-Z neighbor
+struct LightEngine::Area {
+    std::array<Chunk*, LIGHT_AREA_SIZE * LIGHT_AREA_SIZE> chunks;
+    std::array<bool, LIGHT_AREA_SIZE * LIGHT_AREA_SIZE> changed = {};
+
+    Area(const ChunkArea& area) {
+        for (size_t slot = 0; slot < chunks.size(); slot++) {
+            chunks[slot] = area[slot] && area[slot]->IsLightGenerated() ? area[slot].get() : nullptr;
+        }
+    }
+
+    static uint32_t Pack(int x, int y, int z) { return (z * AREA_WIDTH + x) * CHUNK_HEIGHT + y; }
+    static void Unpack(uint32_t position, int& x, int& y, int& z) {
+        y = position % CHUNK_HEIGHT;
+        x = (position / CHUNK_HEIGHT) % AREA_WIDTH;
+        z = position / CHUNK_HEIGHT / AREA_WIDTH;
+    }
+    static bool IsInside(int x, int y, int z) { return x >= 0 && x < AREA_WIDTH && y >= 0 && y < CHUNK_HEIGHT && z >= 0 && z < AREA_WIDTH; }
+    static int GetSlot(int x, int z) { return (z / CHUNK_WIDTH) * LIGHT_AREA_SIZE + x / CHUNK_WIDTH; }
+    static int GetIndex(int x, int y, int z) { return Chunk::ToVoxelIndex(x % CHUNK_WIDTH, y, z % CHUNK_WIDTH); }
+
+    void SetLight(int slot, int index, uint8_t light) {
+        chunks[slot]->m_Light[index].store(light, std::memory_order_relaxed);
+        changed[slot] = true;
+    }
+};
+
+void LightEngine::LightChunk(const ChunkArea& chunks) {
+    PROFILE_SCOPE("LightEngine::LightChunk");
+
+    Chunk& chunk = *chunks[CHUNK_AREA_CENTER];
+
+    // Alone first, sunlight only, in a local copy nobody else reads
+    std::array<uint8_t, NB_VOXELS_IN_CHUNK> sunlight = {};
+    thread_local std::vector<uint16_t> queue;
+    for (int z = 0; z < CHUNK_WIDTH; z++) {
+        for (int x = 0; x < CHUNK_WIDTH; x++) {
+            for (int y = CHUNK_HEIGHT - 1; y >= 0; y--) {
+                const int index = Chunk::ToVoxelIndex(x, y, z);
+                if (chunk.IsOpaque(index)) break;
+                sunlight[index] = LIGHT_MAX;
+            }
+        }
+    }
+
+    // Sideways from the sunlit voxels next to dark air, under overhangs and into caves
+    auto isDarkAir = [&](int x, int y, int z) {
+        if (x < 0 || x >= CHUNK_WIDTH || z < 0 || z >= CHUNK_WIDTH) return false;
+        const int index = Chunk::ToVoxelIndex(x, y, z);
+        return sunlight[index] == 0 && !chunk.IsOpaque(index);
+    };
+    for (int index = 0; index < NB_VOXELS_IN_CHUNK; index++) {
+        if (sunlight[index] != LIGHT_MAX) continue;
+        const int y = index % CHUNK_HEIGHT;
+        const int x = (index / CHUNK_HEIGHT) % CHUNK_WIDTH;
+        const int z = index / CHUNK_HEIGHT / CHUNK_WIDTH;
+        if (isDarkAir(x + 1, y, z) || isDarkAir(x - 1, y, z) || isDarkAir(x, y, z + 1) || isDarkAir(x, y, z - 1)) {
+            queue.push_back(static_cast<uint16_t>(index));
+        }
+    }
+    for (size_t head = 0; head < queue.size(); head++) {
+        const int index = queue[head];
+        const int level = sunlight[index];
+        if (level <= 1) continue;
+
+        const int y = index % CHUNK_HEIGHT;
+        const int x = (index / CHUNK_HEIGHT) % CHUNK_WIDTH;
+        const int z = index / CHUNK_HEIGHT / CHUNK_WIDTH;
+        for (const auto& direction : DIRECTIONS) {
+            const int nx = x + direction[0], ny = y + direction[1], nz = z + direction[2];
+            if (nx < 0 || nx >= CHUNK_WIDTH || ny < 0 || ny >= CHUNK_HEIGHT || nz < 0 || nz >= CHUNK_WIDTH) continue;
+            const int neighbor = Chunk::ToVoxelIndex(nx, ny, nz);
+            if (chunk.IsOpaque(neighbor) || sunlight[neighbor] >= level - 1) continue;
+            sunlight[neighbor] = static_cast<uint8_t>(level - 1);
+            queue.push_back(static_cast<uint16_t>(neighbor));
+        }
+    }
+    queue.clear();
+    for (int index = 0; index < NB_VOXELS_IN_CHUNK; index++) {
+        chunk.m_Light[index].store(static_cast<uint8_t>(sunlight[index] << SUN_SHIFT), std::memory_order_relaxed);
+    }
+
+    // Then joined to the lit chunks around: light flows both ways across the borders, sources are added
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    chunk.m_LightGenerated.store(true, std::memory_order_release);
+    Area area(chunks);
+    const glm::ivec3 origin = glm::ivec3(chunk.GetPosition()) - glm::ivec3(CHUNK_WIDTH, 0, CHUNK_WIDTH);
+
+    // Voxel pairs on both sides of each lit border
+    auto pushBorders = [&]() {
+        for (int i = 0; i < CHUNK_WIDTH; i++) {
+            for (int y = 0; y < CHUNK_HEIGHT; y++) {
+                const int t = CHUNK_WIDTH + i;
+                if (area.chunks[Area::GetSlot(CHUNK_WIDTH - 1, t)]) {
+                    m_Queue.push_back(Area::Pack(CHUNK_WIDTH, y, t));
+                    m_Queue.push_back(Area::Pack(CHUNK_WIDTH - 1, y, t));
+                }
+                if (area.chunks[Area::GetSlot(2 * CHUNK_WIDTH, t)]) {
+                    m_Queue.push_back(Area::Pack(2 * CHUNK_WIDTH - 1, y, t));
+                    m_Queue.push_back(Area::Pack(2 * CHUNK_WIDTH, y, t));
+                }
+                if (area.chunks[Area::GetSlot(t, CHUNK_WIDTH - 1)]) {
+                    m_Queue.push_back(Area::Pack(t, y, CHUNK_WIDTH));
+                    m_Queue.push_back(Area::Pack(t, y, CHUNK_WIDTH - 1));
+                }
+                if (area.chunks[Area::GetSlot(t, 2 * CHUNK_WIDTH)]) {
+                    m_Queue.push_back(Area::Pack(t, y, 2 * CHUNK_WIDTH - 1));
+                    m_Queue.push_back(Area::Pack(t, y, 2 * CHUNK_WIDTH));
+                }
+            }
+        }
+    };
+    pushBorders();
+    PropagateIncrease(area, SUN_SHIFT);
+    pushBorders();
+    SeedSources(area, origin);
+    PropagateIncrease(area, BLOCK_SHIFT);
+
+    // Meshed neighbors lit the faces looking into this chunk as full sunlight while it was not lit yet
+    auto markDimBorder = [&](int x, int z, int dx, int dz) {
+        const int slot = Area::GetSlot(x + dx, z + dz);
+        if (!area.chunks[slot]) return;
+        for (int i = 0; i < CHUNK_WIDTH; i++) {
+            for (int y = 0; y < CHUNK_HEIGHT; y++) {
+                const int index = Area::GetIndex(x + i * (dx == 0), y, z + i * (dz == 0));
+                const uint8_t light = chunk.GetLight(index);
+                if (!chunk.IsOpaque(index) && std::max(light >> SUN_SHIFT, light & 0x0F) < LIGHT_MAX) {
+                    area.changed[slot] = true;
+                    return;
+                }
+            }
+        }
+    };
+    markDimBorder(CHUNK_WIDTH, CHUNK_WIDTH, -1, 0);
+    markDimBorder(2 * CHUNK_WIDTH - 1, CHUNK_WIDTH, 1, 0);
+    markDimBorder(CHUNK_WIDTH, CHUNK_WIDTH, 0, -1);
+    markDimBorder(CHUNK_WIDTH, 2 * CHUNK_WIDTH - 1, 0, 1);
+
+    area.changed[CHUNK_AREA_CENTER] = false;  // Meshed right after by the caller
+    MarkDirty(area, chunks);
+}
+
+void LightEngine::SetSource(const ChunkArea& chunks, const glm::ivec3& worldVoxel, uint8_t level) {
+    PROFILE_SCOPE("LightEngine::SetSource");
+
+    level = std::min(level, LIGHT_MAX);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    auto it = m_Sources.find(worldVoxel);
+    const uint8_t previous = it != m_Sources.end() ? it->second : 0;
+    if (level == 0) {
+        if (it != m_Sources.end()) m_Sources.erase(it);
+    } else {
+        m_Sources[worldVoxel] = level;
+    }
+
+    const Chunk& center = *chunks[CHUNK_AREA_CENTER];
+    if (!center.IsLightGenerated()) return;  // Seeded when the chunk gets lit
+
+    Area area(chunks);
+    const glm::ivec3 origin = glm::ivec3(center.GetPosition()) - glm::ivec3(CHUNK_WIDTH, 0, CHUNK_WIDTH);
+    const glm::ivec3 local = worldVoxel - origin;
+    const int slot = Area::GetSlot(local.x, local.z);
+    const int index = Area::GetIndex(local.x, local.y, local.z);
+    const uint8_t light = area.chunks[slot]->GetLight(index);
+    const uint8_t current = light & 0x0F;
+
+    if (level < previous) {
+        // Darken what the old light may have reached, then refill it from the light left around and the other sources
+        area.SetLight(slot, index, light & 0xF0);
+        m_RemovalQueue.emplace_back(Area::Pack(local.x, local.y, local.z), current);
+        PropagateRemoval(area);
+        SeedSources(area, origin);
+    } else if (level > current) {
+        area.SetLight(slot, index, (light & 0xF0) | level);
+        m_Queue.push_back(Area::Pack(local.x, local.y, local.z));
+    }
+    PropagateIncrease(area, BLOCK_SHIFT);
+    MarkDirty(area, chunks);
+}
+
+void LightEngine::TakeDirtyChunks(std::vector<std::weak_ptr<Chunk>>& chunks) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    chunks.insert(chunks.end(), m_DirtyChunks.begin(), m_DirtyChunks.end());
+    m_DirtyChunks.clear();
+}
+
+size_t LightEngine::GetNbSources() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Sources.size();
+}
+
+void LightEngine::PropagateIncrease(Area& area, int shift) {
+    for (size_t head = 0; head < m_Queue.size(); head++) {
+        int x, y, z;
+        Area::Unpack(m_Queue[head], x, y, z);
+        const int level = (area.chunks[Area::GetSlot(x, z)]->GetLight(Area::GetIndex(x, y, z)) >> shift) & 0x0F;
+        if (level <= 1) continue;
+
+        for (const auto& direction : DIRECTIONS) {
+            const int nx = x + direction[0], ny = y + direction[1], nz = z + direction[2];
+            if (!Area::IsInside(nx, ny, nz)) continue;
+            const int slot = Area::GetSlot(nx, nz);
+            Chunk* chunk = area.chunks[slot];
+            if (chunk == nullptr) continue;
+            const int index = Area::GetIndex(nx, ny, nz);
+            if (chunk->IsOpaque(index)) continue;
+
+            // Full sunlight falls down a column without fading
+            const int spread = (shift == SUN_SHIFT && level == LIGHT_MAX && direction[1] == -1) ? LIGHT_MAX : level - 1;
+            const uint8_t light = chunk->GetLight(index);
+            if (((light >> shift) & 0x0F) >= spread) continue;
+            area.SetLight(slot, index, static_cast<uint8_t>((light & ~(0x0F << shift)) | (spread << shift)));
+            m_Queue.push_back(Area::Pack(nx, ny, nz));
+        }
+    }
+    m_Queue.clear();
+}
+
+void LightEngine::PropagateRemoval(Area& area) {
+    for (size_t head = 0; head < m_RemovalQueue.size(); head++) {
+        const auto [position, level] = m_RemovalQueue[head];
+        int x, y, z;
+        Area::Unpack(position, x, y, z);
+
+        for (const auto& direction : DIRECTIONS) {
+            const int nx = x + direction[0], ny = y + direction[1], nz = z + direction[2];
+            if (!Area::IsInside(nx, ny, nz)) continue;
+            const int slot = Area::GetSlot(nx, nz);
+            Chunk* chunk = area.chunks[slot];
+            if (chunk == nullptr) continue;
+            const int index = Area::GetIndex(nx, ny, nz);
+            const uint8_t light = chunk->GetLight(index);
+            const uint8_t neighborLevel = light & 0x0F;
+            if (neighborLevel == 0) continue;
+
+            if (neighborLevel < level) {
+                // Lit by the removed light, darkened in turn
+                area.SetLight(slot, index, light & 0xF0);
+                m_RemovalQueue.emplace_back(Area::Pack(nx, ny, nz), neighborLevel);
+            } else {
+                m_Queue.push_back(Area::Pack(nx, ny, nz));  // Lit from elsewhere, refills the darkened voxels
+            }
+        }
+    }
+    m_RemovalQueue.clear();
+}
+
+void LightEngine::SeedSources(Area& area, const glm::ivec3& origin) {
+    for (const auto& [voxel, level] : m_Sources) {
+        const glm::ivec3 local = voxel - origin;
+        if (!Area::IsInside(local.x, local.y, local.z)) continue;
+        const int slot = Area::GetSlot(local.x, local.z);
+        if (area.chunks[slot] == nullptr) continue;
+
+        const int index = Area::GetIndex(local.x, local.y, local.z);
+        const uint8_t light = area.chunks[slot]->GetLight(index);
+        if ((light & 0x0F) >= level) continue;
+        area.SetLight(slot, index, (light & 0xF0) | level);
+        m_Queue.push_back(Area::Pack(local.x, local.y, local.z));
+    }
+}
+
+void LightEngine::MarkDirty(const Area& area, const ChunkArea& chunks) {
+    for (size_t slot = 0; slot < chunks.size(); slot++) {
+        if (area.changed[slot]) m_DirtyChunks.push_back(chunks[slot]);
+    }
+}
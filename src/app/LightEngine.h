@@ -0,0 +1,61 @@
+#ifndef __LIGHT_ENGINE_H__
+#define __LIGHT_ENGINE_H__
+
+#include <array>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Chunk.h"
+
+constexpr int LIGHT_AREA_SIZE = 3;  // Chunks per side of what one update may touch
+static_assert(LIGHT_MAX < CHUNK_WIDTH, "Light must fade out before crossing a whole chunk, updates only see the chunks around");
+
+// Chunks around a center chunk, indexed [(dz + 1) * LIGHT_AREA_SIZE + dx + 1], nullptr where not loaded
+using ChunkArea = std::array<std::shared_ptr<Chunk>, LIGHT_AREA_SIZE * LIGHT_AREA_SIZE>;
+constexpr int CHUNK_AREA_CENTER = LIGHT_AREA_SIZE * LIGHT_AREA_SIZE / 2;
+
+// Sunlight and block light flood fill over the chunk voxels, on the worker threads.
+// A chunk is first lit alone: sunlight falls down each column then spreads sideways, without locking so chunks light in
+// parallel. It is then joined to its lit neighbors under the engine lock, light flowing both ways across the borders.
+// Light sources are added and removed incrementally: removal darkens what the old light reached then refills it from the
+// light around. Chunks whose light changed are listed so their meshes get rebuilt.
+class LightEngine {
+   public:
+    LightEngine() = default;
+
+    // From the mesh job of the center chunk, its data and its neighbors' must be generated
+    void LightChunk(const ChunkArea& area);
+
+    // Block light emitted at a world voxel of the area's center chunk, y within the chunk height. Level 0 removes the source
+    void SetSource(const ChunkArea& area, const glm::ivec3& worldVoxel, uint8_t level);
+
+    // Chunks whose light changed since the last call, other than a chunk being lit for the first time
+    void TakeDirtyChunks(std::vector<std::weak_ptr<Chunk>>& chunks);
+
+    /* Getters */
+    size_t GetNbSources() const;
+
+   private:
+    struct Area;
+
+    void PropagateIncrease(Area& area, int shift);
+    void PropagateRemoval(Area& area);
+    void SeedSources(Area& area, const glm::ivec3& origin);
+    void MarkDirty(const Area& area, const ChunkArea& chunks);
+
+    mutable std::mutex m_Mutex;
+    std::unordered_map<glm::ivec3, uint8_t> m_Sources;  // World voxel to emitted level, kept while chunks are unloaded
+    std::vector<std::weak_ptr<Chunk>> m_DirtyChunks;
+
+    // Scratch queues reused by every update under the lock, voxels packed as area positions
+    std::vector<uint32_t> m_Queue;
+    std::vector<std::pair<uint32_t, uint8_t>> m_RemovalQueue;
+};
+
+#endif  // __LIGHT_ENGINE_H__
@@ -0,0 +1,132 @@
+#include "LodTile.h"
+
+#include "RegionCache.h"
+#include "RegionStore.h"
+#include "events/EventApplication.h"
+#include "events/EventDispatcher.h"
+#include "pch.h"
+#include "utils/Profiler.h"
+
+LodTile::LodTile(const glm::ivec2& origin, int level)
+    : Renderable(glm::vec3(origin.x * CHUNK_WIDTH, 0, origin.y * CHUNK_WIDTH), 1),
+      m_Origin(origin),
+      m_Level(level),
+      m_NbCellsHigh(CHUNK_HEIGHT >> level),
+      m_MeshGenerated(false) {
+    m_ShaderName = "gbuffer_terrain";
+}
+
+LodTile::~LodTile() { Unregister(); }
+
+void LodTile::Generate(RegionCache& regions, RegionStore* store) {
+    PROFILE_SCOPE("LodTile::Generate");
+
+    // Chunks read back like ChunkManager loads them, so edited chunks look the same from afar. The others are never built,
+    // the generated terrain is a heightmap and the column heights give their cells
+    m_Cells.assign(CHUNK_WIDTH * CHUNK_WIDTH * m_NbCellsHigh, 0);
+    BlockArray blocks;
+    for (int z = 0; z < GetSize(); z++) {
+        for (int x = 0; x < GetSize(); x++) {
+            const glm::ivec2 coord = m_Origin + glm::ivec2(x, z);
+            if (store != nullptr && store->Load(coord, blocks)) {
+                Downsample(blocks, x, z);
+            } else {
+                DownsampleHeights(*regions.GetRegion(coord.x * CHUNK_WIDTH, coord.y * CHUNK_WIDTH), x, z);
+            }
+        }
+    }
+
+    GenerateMesh();
+    std::vector<uint16_t>().swap(m_Cells);
+
+    m_MeshGenerated.store(true, std::memory_order_release);
+    AddNewRenderableEvent event(this);
+    EventDispatcher::Get().Dispatch(event);
+}
+
+void LodTile::Update() {}
+
+void LodTile::Downsample(const BlockArray& blocks, int chunkX, int chunkZ) {
+    // Solid voxels counted per cell, the majority vote happens when meshing
+    for (int z = 0; z < CHUNK_WIDTH; z++) {
+        const int cellZ = (chunkZ * CHUNK_WIDTH + z) >> m_Level;
+        for (int x = 0; x < CHUNK_WIDTH; x++) {
+            const int cellX = (chunkX * CHUNK_WIDTH + x) >> m_Level;
+            const Block* column = &blocks[Chunk::ToVoxelIndex(x, 0, z)];
+            uint16_t* cellColumn = &m_Cells[GetCellIndex(cellX, 0, cellZ)];
+            for (int y = 0; y < CHUNK_HEIGHT; y++) cellColumn[y >> m_Level] += column[y] != Block::Air;
+        }
+    }
+}
+
+void LodTile::DownsampleHeights(const Region& region, int chunkX, int chunkZ) {
+    const int cellHeight = GetSize();
+    const int worldX = (m_Origin.x + chunkX) * CHUNK_WIDTH;
+    for (int z = 0; z < CHUNK_WIDTH; z++) {
+        const int cellZ = (chunkZ * CHUNK_WIDTH + z) >> m_Level;
+        const float* row = region.GetHeightRow(worldX, (m_Origin.y + chunkZ) * CHUNK_WIDTH + z);
+        for (int x = 0; x < CHUNK_WIDTH; x++) {
+            const int cellX = (chunkX * CHUNK_WIDTH + x) >> m_Level;
+            // Voxels up to the column height are solid, as in Chunk::GenerateBlocks
+            const int nbSolid = std::min(Chunk::ToColumnHeight(row[x]) + 1, CHUNK_HEIGHT);
+            uint16_t* cellColumn = &m_Cells[GetCellIndex(cellX, 0, cellZ)];
+            for (int cellY = 0; cellY < m_NbCellsHigh && cellY * cellHeight < nbSolid; cellY++) {
+                cellColumn[cellY] += std::min(nbSolid - cellY * cellHeight, cellHeight);
+            }
+        }
+    }
+}
+
+void LodTile::GenerateMesh() {
+    const int scale = GetSize();
+    const int nbVoxelsInCell = scale * scale * scale;
+    auto isSolid = [this, nbVoxelsInCell](int x, int y, int z) { return 2 * m_Cells[GetCellIndex(x, y, z)] >= nbVoxelsInCell; };
+
+    // Highest solid cell of each column, the skirts hang from it
+    std::array<int, CHUNK_WIDTH * CHUNK_WIDTH> tops;
+    for (int z = 0; z < CHUNK_WIDTH; z++) {
+        for (int x = 0; x < CHUNK_WIDTH; x++) {
+            int y = m_NbCellsHigh - 1;
+            while (y >= 0 && !isSolid(x, y, z)) y--;
+            tops[z * CHUNK_WIDTH + x] = y;
+        }
+    }
+    const int nbSkirtCells = std::max(1, LOD_SKIRT_DEPTH / scale);
+
+    for (int z = 0; z < CHUNK_WIDTH; z++) {
+        for (int x = 0; x < CHUNK_WIDTH; x++) {
+            const int top = tops[z * CHUNK_WIDTH + x];
+            for (int y = 0; y <= top; y++) {
+                if (!isSolid(x, y, z)) continue;
+
+                for (int i = 0; i < 6; i++) {
+                    const auto face = static_cast<Voxel::Face>(i);
+                    const glm::ivec3 neighbor = glm::ivec3(x, y, z) + Chunk::GetFaceNormal(face);
+                    bool visible;
+                    if (neighbor.y < 0) {
+                        visible = false;
+                    } else if (neighbor.y >= m_NbCellsHigh) {
+                        visible = true;
+                    } else if (neighbor.x < 0 || neighbor.x >= CHUNK_WIDTH || neighbor.z < 0 || neighbor.z >= CHUNK_WIDTH) {
+                        visible = y > top - nbSkirtCells;  // Skirt
+                    } else {
+                        visible = !isSolid(neighbor.x, neighbor.y, neighbor.z);
+                    }
+                    if (!visible) continue;
+
+                    // Unit cube face scaled to the cell, full sunlight and no occlusion from afar
+                    std::array<float, 4 * CHUNK_VERTEX_SIZE> vertices = Chunk::GetFaceVertices(face);
+                    for (size_t v = 0; v < vertices.size(); v += CHUNK_VERTEX_SIZE) {
+                        vertices[v] = (vertices[v] + x) * scale;
+                        vertices[v + 1] = (vertices[v + 1] + y) * scale;
+                        vertices[v + 2] = (vertices[v + 2] + z) * scale;
+                    }
+                    m_BackMesh.vertices.insert(m_BackMesh.vertices.end(), vertices.begin(), vertices.end());
+                    AddFaceToIndices();
+                }
+            }
+        }
+    }
+
+    CommitMesh();
+}
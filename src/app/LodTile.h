@@ -0,0 +1,59 @@
+#ifndef __LOD_TILE_H__
+#define __LOD_TILE_H__
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+#include "Chunk.h"
+#include "gfx/Renderable.h"
+
+class RegionCache;
+class RegionStore;
+struct Region;
+
+constexpr int LOD_NB_LEVELS = 4;  // Full chunks, then the voxel data downsampled 2x, 4x and 8x
+constexpr int LOD_MAX_LEVEL = LOD_NB_LEVELS - 1;
+// Where the ring of each level ends, in render distances: 16, 24, 40 and 64 chunks at the default distance
+constexpr std::array<float, LOD_NB_LEVELS> LOD_RING_SCALES = {1.0f, 1.5f, 2.5f, 4.0f};
+constexpr int LOD_SKIRT_DEPTH = 8;  // Voxels the tile borders hang below the surface, covering the cracks against other levels
+static_assert((CHUNK_HEIGHT >> LOD_MAX_LEVEL) > 0, "The coarsest cells must fit in the chunk height");
+
+// Square of 2^level x 2^level chunks meshed with cells of 2^level voxels per side, for the rings beyond the loaded chunks.
+// A cell is solid when most of its voxels are, so every tile is a chunk sized grid of about one chunk's triangles.
+// Only the mesh is kept, until the upload. The neighbors may be finer or coarser, so the tile borders get their outer
+// faces as skirts from the surface down to LOD_SKIRT_DEPTH.
+class LodTile : public Renderable, public std::enable_shared_from_this<LodTile> {
+   public:
+    LodTile(const glm::ivec2& origin, int level);  // Origin in chunk coordinates, a multiple of the tile size
+    ~LodTile();
+
+    // From a worker: downsamples the saved chunks of the tile and the heightmap of the others, then meshes the cells
+    void Generate(RegionCache& regions, RegionStore* store);
+    void Update() override;
+
+    /* Getters */
+    const glm::ivec2& GetOrigin() const { return m_Origin; }
+    int GetLevel() const { return m_Level; }
+    int GetSize() const { return GetSize(m_Level); }
+    bool IsMeshGenerated() const { return m_MeshGenerated.load(std::memory_order_acquire); }
+
+    static int GetSize(int level) { return 1 << level; }  // Chunks per side
+
+   private:
+    void Downsample(const BlockArray& blocks, int chunkX, int chunkZ);
+    void DownsampleHeights(const Region& region, int chunkX, int chunkZ);  // Same cells as Downsample of the generated blocks
+    void GenerateMesh();
+    int GetCellIndex(int x, int y, int z) const { return y + x * m_NbCellsHigh + z * CHUNK_WIDTH * m_NbCellsHigh; }
+
+    glm::ivec2 m_Origin;
+    int m_Level;
+    int m_NbCellsHigh;
+    std::atomic<bool> m_MeshGenerated;
+    std::vector<uint16_t> m_Cells;  // Solid voxels per cell while generating, indexed like the chunk voxels
+};
+
+#endif  // __LOD_TILE_H__
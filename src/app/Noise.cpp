@@ -1,8 +1,86 @@
 #include "Noise.h"
 
+#include "NoiseKernel.h"
+#include "pch.h"
 #include "utils/Logger.h"
 
-Noise::Noise() {
+#if defined(VOXELINITY_NOISE_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+Noise::Noise(int seed, float frequency) : m_Seed(seed), m_Frequency(frequency), m_Backend(GetBestBackend()) {
     m_Handler.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-    // m_Handler.SetFrequency(0.06f);
+    m_Handler.SetSeed(seed);
+    m_Handler.SetFrequency(frequency);
+}
+
+Noise::Backend Noise::GetBestBackend() {
+#if !defined(VOXELINITY_NOISE_X86)
+    return Backend::Scalar;
+#elif defined(_MSC_VER)
+    static const Backend s_Best = []() {
+        int info[4];
+        __cpuid(info, 1);
+        const bool sse41 = (info[2] & (1 << 19)) != 0;
+        const bool osAVX = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;  // OS saves the YMM registers
+        __cpuidex(info, 7, 0);
+        const bool avx2 = osAVX && (info[1] & (1 << 5)) != 0;
+        return avx2 ? Backend::AVX2 : sse41 ? Backend::SSE41 : Backend::Scalar;
+    }();
+    return s_Best;
+#else
+    if (__builtin_cpu_supports("avx2")) return Backend::AVX2;
+    if (__builtin_cpu_supports("sse4.1")) return Backend::SSE41;
+    return Backend::Scalar;
+#endif
+}
+
+const char* Noise::GetBackendName(Backend backend) {
+    switch (backend) {
+        case Backend::Scalar:
+            return "Scalar";
+        case Backend::SSE41:
+            return "SSE4.1";
+        case Backend::AVX2:
+            return "AVX2";
+    }
+    return "Unknown";
+}
+
+void Noise::GenerateTile(int originX, int originZ, int width, int depth, float* out) const {
+    for (int z = 0; z < depth; z++) {
+        float* row = out + z * width;
+        switch (m_Backend) {
+#ifdef VOXELINITY_NOISE_X86
+            case Backend::AVX2:
+                GenerateNoiseRowAVX2(m_Seed, m_Frequency, originX, originZ + z, width, row);
+                break;
+            case Backend::SSE41:
+                GenerateNoiseRowSSE41(m_Seed, m_Frequency, originX, originZ + z, width, row);
+                break;
+#endif
+            default:
+                for (int x = 0; x < width; x++) row[x] = GetNoise(static_cast<float>(originX + x), static_cast<float>(originZ + z));
+                break;
+        }
+    }
+}
+
+void Noise::SetBackend(Backend backend) {
+    const Backend best = GetBestBackend();
+    if (static_cast<int>(backend) > static_cast<int>(best)) {
+        LOG_WARNING("Noise: {0} is not supported by this CPU, using {1}", GetBackendName(backend), GetBackendName(best));
+        backend = best;
+    }
+    m_Backend = backend;
+}
+
+void Noise::SetSeed(int seed) {
+    m_Seed = seed;
+    m_Handler.SetSeed(seed);
+}
+
+void Noise::SetFrequency(float frequency) {
+    m_Frequency = frequency;
+    m_Handler.SetFrequency(frequency);
 }
@@ -3,18 +3,37 @@
 
 #include <FastNoiseLite.h>
 
-#include <vector>
-
+// 2D OpenSimplex2 terrain noise, single samples through FastNoiseLite or whole tiles through SIMD kernels
 class Noise {
    public:
-    Noise();
+    // Batch kernel, picked once from the CPU features
+    enum class Backend { Scalar = 0, SSE41, AVX2 };
+
+    Noise(int seed = 1337, float frequency = 0.01f);
+
+    float GetNoise(float x, float z) const { return m_Handler.GetNoise(x, z); }
+
+    // out[z * width + x] = GetNoise(originX + x, originZ + z), same values as the single sample path
+    void GenerateTile(int originX, int originZ, int width, int depth, float* out) const;
+
+    static Backend GetBestBackend();  // Widest kernel the CPU runs
+    static const char* GetBackendName(Backend backend);
 
     /* Getters */
-    const std::vector<float>& GetNoiseData() const { return m_NoiseData; }
+    Backend GetBackend() const { return m_Backend; }
+    int GetSeed() const { return m_Seed; }
+    float GetFrequency() const { return m_Frequency; }
+
+    /* Setters */
+    void SetBackend(Backend backend);  // Falls back to the best supported one if the CPU lacks it
+    void SetSeed(int seed);
+    void SetFrequency(float frequency);
 
    private:
     FastNoiseLite m_Handler;
-    std::vector<float> m_NoiseData;
+    int m_Seed;
+    float m_Frequency;
+    Backend m_Backend;
 };
 
-#endif  // __NOISE_H__
\ No newline at end of file
+#endif  // __NOISE_H__
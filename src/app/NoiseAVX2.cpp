@@ -0,0 +1,47 @@
+#include "NoiseKernel.h"
+
+#ifdef VOXELINITY_NOISE_X86
+#include <immintrin.h>
+
+// 8 lanes, built with -mavx2 (see CMakeLists.txt); only called when the CPU and OS report AVX2.
+// No FMA on purpose: fused multiply adds would round differently from the scalar path.
+struct AVX2 {
+    using Float = __m256;
+    using Int = __m256i;
+    static constexpr int WIDTH = 8;
+
+    static Float Set(float value) { return _mm256_set1_ps(value); }
+    static Int SetI(int value) { return _mm256_set1_epi32(value); }
+    static Int LaneIndices() { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+
+    static Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+    static Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+    static Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+    static Float And(Float mask, Float value) { return _mm256_and_ps(mask, value); }
+    static Float Less(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static Float Greater(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static Float Select(Float mask, Float a, Float b) { return _mm256_blendv_ps(b, a, mask); }
+
+    static Int AddI(Int a, Int b) { return _mm256_add_epi32(a, b); }
+    static Int MulI(Int a, Int b) { return _mm256_mullo_epi32(a, b); }
+    static Int XorI(Int a, Int b) { return _mm256_xor_si256(a, b); }
+    static Int AndI(Int a, Int b) { return _mm256_and_si256(a, b); }
+    template <int Shift>
+    static Int ShiftRightI(Int a) {
+        return _mm256_srai_epi32(a, Shift);
+    }
+    static Int SelectI(Int mask, Int a, Int b) { return _mm256_blendv_epi8(b, a, mask); }
+
+    static Float ToFloat(Int a) { return _mm256_cvtepi32_ps(a); }
+    static Int Truncate(Float a) { return _mm256_cvttps_epi32(a); }
+    static Int MaskToInt(Float mask) { return _mm256_castps_si256(mask); }  // All ones, -1, in the selected lanes
+
+    static Float Gather(const float* table, Int indices) { return _mm256_i32gather_ps(table, indices, 4); }
+
+    static void Store(float* out, Float value) { _mm256_storeu_ps(out, value); }
+};
+
+void GenerateNoiseRowAVX2(int seed, float frequency, int originX, int z, int width, float* out) {
+    NoiseKernel::GenerateRow<AVX2>(seed, frequency, originX, z, width, out);
+}
+#endif
@@ -0,0 +1,142 @@
+#ifndef __NOISE_KERNEL_H__
+#define __NOISE_KERNEL_H__
+
+#include <array>
+#include <cstring>
+
+// x86 builds get the SSE4.1 and AVX2 kernels, compiled in their own translation units with the matching flags
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VOXELINITY_NOISE_X86
+#endif
+
+// One row of a tile, x from originX to originX + width - 1 at world z, see Noise::GenerateTile
+void GenerateNoiseRowSSE41(int seed, float frequency, int originX, int z, int width, float* out);
+void GenerateNoiseRowAVX2(int seed, float frequency, int originX, int z, int width, float* out);
+
+namespace NoiseKernel {
+
+// FastNoiseLite's Gradients2D table (private there): 24 directions repeated 5 times, then 8 more
+constexpr float GRADIENT_DIRECTIONS[32][2] = {
+    {0.130526192220052f, 0.99144486137381f},    {0.38268343236509f, 0.923879532511287f},   {0.608761429008721f, 0.793353340291235f},
+    {0.793353340291235f, 0.608761429008721f},   {0.923879532511287f, 0.38268343236509f},   {0.99144486137381f, 0.130526192220051f},
+    {0.99144486137381f, -0.130526192220051f},   {0.923879532511287f, -0.38268343236509f},  {0.793353340291235f, -0.60876142900872f},
+    {0.608761429008721f, -0.793353340291235f},  {0.38268343236509f, -0.923879532511287f},  {0.130526192220052f, -0.99144486137381f},
+    {-0.130526192220052f, -0.99144486137381f},  {-0.38268343236509f, -0.923879532511287f}, {-0.608761429008721f, -0.793353340291235f},
+    {-0.793353340291235f, -0.608761429008721f}, {-0.923879532511287f, -0.38268343236509f}, {-0.99144486137381f, -0.130526192220052f},
+    {-0.99144486137381f, 0.130526192220051f},   {-0.923879532511287f, 0.38268343236509f},  {-0.793353340291235f, 0.608761429008721f},
+    {-0.608761429008721f, 0.793353340291235f},  {-0.38268343236509f, 0.923879532511287f},  {-0.130526192220052f, 0.99144486137381f},
+    {0.38268343236509f, 0.923879532511287f},    {0.923879532511287f, 0.38268343236509f},   {0.923879532511287f, -0.38268343236509f},
+    {0.38268343236509f, -0.923879532511287f},   {-0.38268343236509f, -0.923879532511287f}, {-0.923879532511287f, -0.38268343236509f},
+    {-0.923879532511287f, 0.38268343236509f},   {-0.38268343236509f, 0.923879532511287f},
+};
+
+constexpr std::array<float, 256> MakeGradients() {
+    std::array<float, 256> gradients = {};
+    for (int pair = 0; pair < 128; pair++) {
+        const int direction = pair < 120 ? pair % 24 : 24 + pair - 120;
+        gradients[pair * 2] = GRADIENT_DIRECTIONS[direction][0];
+        gradients[pair * 2 + 1] = GRADIENT_DIRECTIONS[direction][1];
+    }
+    return gradients;
+}
+alignas(32) inline constexpr std::array<float, 256> GRADIENTS_2D = MakeGradients();
+
+constexpr int PRIME_X = 501125321;
+constexpr int PRIME_Y = 1136930381;
+constexpr int HASH_MULTIPLIER = 0x27d4eb2d;
+
+// FastNoiseLite's constants, built with the same float expressions so results match bit for bit
+constexpr float SQRT3 = 1.7320508075688772935274463415059f;
+constexpr float F2 = 0.5f * (SQRT3 - 1);
+constexpr float G2 = (3 - SQRT3) / 6;
+constexpr float C_T = (float)(2 * (1 - 2 * G2) * (1 / G2 - 2));
+constexpr float C_A = (float)(-2 * (1 - 2 * G2) * (1 - 2 * G2));
+constexpr float SCALE = 99.83685446303647f;
+
+// Gradient dot product of FastNoiseLite::GradCoord, on V::WIDTH lanes
+template <typename V>
+typename V::Float GradCoord(typename V::Int seed, typename V::Int xPrimed, typename V::Int yPrimed, typename V::Float xd, typename V::Float yd) {
+    typename V::Int hash = V::MulI(V::XorI(V::XorI(seed, xPrimed), yPrimed), V::SetI(HASH_MULTIPLIER));
+    hash = V::XorI(hash, V::template ShiftRightI<15>(hash));
+    hash = V::AndI(hash, V::SetI(127 << 1));
+
+    const typename V::Float xg = V::Gather(GRADIENTS_2D.data(), hash);
+    const typename V::Float yg = V::Gather(GRADIENTS_2D.data() + 1, hash);
+    return V::Add(V::Mul(xd, xg), V::Mul(yd, yg));
+}
+
+// FastNoiseLite::SingleSimplex after TransformNoiseCoordinate, branches turned into lane masks
+template <typename V>
+typename V::Float Simplex(int seedValue, float frequency, typename V::Float x, typename V::Float y) {
+    using F = typename V::Float;
+    using I = typename V::Int;
+
+    x = V::Mul(x, V::Set(frequency));
+    y = V::Mul(y, V::Set(frequency));
+    const F skew = V::Mul(V::Add(x, y), V::Set(F2));
+    x = V::Add(x, skew);
+    y = V::Add(y, skew);
+
+    // FastFloor: truncate, minus one below zero (integers included, as FastNoiseLite does)
+    I i = V::AddI(V::Truncate(x), V::MaskToInt(V::Less(x, V::Set(0.0f))));
+    I j = V::AddI(V::Truncate(y), V::MaskToInt(V::Less(y, V::Set(0.0f))));
+    const F xi = V::Sub(x, V::ToFloat(i));
+    const F yi = V::Sub(y, V::ToFloat(j));
+
+    const F t = V::Mul(V::Add(xi, yi), V::Set(G2));
+    const F x0 = V::Sub(xi, t);
+    const F y0 = V::Sub(yi, t);
+
+    i = V::MulI(i, V::SetI(PRIME_X));
+    j = V::MulI(j, V::SetI(PRIME_Y));
+    const I seed = V::SetI(seedValue);
+    const F zero = V::Set(0.0f);
+
+    const F a = V::Sub(V::Sub(V::Set(0.5f), V::Mul(x0, x0)), V::Mul(y0, y0));
+    const F a2 = V::Mul(a, a);
+    const F n0 = V::And(V::Greater(a, zero), V::Mul(V::Mul(a2, a2), GradCoord<V>(seed, i, j, x0, y0)));
+
+    const F c = V::Add(V::Mul(V::Set(C_T), t), V::Add(V::Set(C_A), a));
+    const F x2 = V::Add(x0, V::Set(2 * G2 - 1));
+    const F y2 = V::Add(y0, V::Set(2 * G2 - 1));
+    const F c2 = V::Mul(c, c);
+    const I iX = V::AddI(i, V::SetI(PRIME_X));
+    const I jY = V::AddI(j, V::SetI(PRIME_Y));
+    const F n2 = V::And(V::Greater(c, zero), V::Mul(V::Mul(c2, c2), GradCoord<V>(seed, iX, jY, x2, y2)));
+
+    // Middle vertex: (0, 1) above the diagonal, (1, 0) below
+    const F upper = V::Greater(y0, x0);
+    const F x1 = V::Add(x0, V::Select(upper, V::Set(G2), V::Set(G2 - 1)));
+    const F y1 = V::Add(y0, V::Select(upper, V::Set(G2 - 1), V::Set(G2)));
+    const I upperI = V::MaskToInt(upper);
+    const I i1 = V::SelectI(upperI, i, iX);
+    const I j1 = V::SelectI(upperI, jY, j);
+    const F b = V::Sub(V::Sub(V::Set(0.5f), V::Mul(x1, x1)), V::Mul(y1, y1));
+    const F b2 = V::Mul(b, b);
+    const F n1 = V::And(V::Greater(b, zero), V::Mul(V::Mul(b2, b2), GradCoord<V>(seed, i1, j1, x1, y1)));
+
+    return V::Mul(V::Add(V::Add(n0, n1), n2), V::Set(SCALE));
+}
+
+template <typename V>
+void GenerateRow(int seed, float frequency, int originX, int z, int width, float* out) {
+    const typename V::Float zs = V::Set(static_cast<float>(z));
+
+    int x = 0;
+    for (; x + V::WIDTH <= width; x += V::WIDTH) {
+        const typename V::Float xs = V::ToFloat(V::AddI(V::SetI(originX + x), V::LaneIndices()));
+        V::Store(out + x, Simplex<V>(seed, frequency, xs, zs));
+    }
+
+    // Tail narrower than a vector
+    if (x < width) {
+        alignas(32) float lanes[V::WIDTH];
+        const typename V::Float xs = V::ToFloat(V::AddI(V::SetI(originX + x), V::LaneIndices()));
+        V::Store(lanes, Simplex<V>(seed, frequency, xs, zs));
+        std::memcpy(out + x, lanes, (width - x) * sizeof(float));
+    }
+}
+
+}  // namespace NoiseKernel
+
+#endif  // __NOISE_KERNEL_H__
@@ -0,0 +1,51 @@
+#include "NoiseKernel.h"
+
+#ifdef VOXELINITY_NOISE_X86
+#include <smmintrin.h>
+
+// 4 lanes, built with -msse4.1 (see CMakeLists.txt); only called when the CPU reports SSE4.1
+struct SSE41 {
+    using Float = __m128;
+    using Int = __m128i;
+    static constexpr int WIDTH = 4;
+
+    static Float Set(float value) { return _mm_set1_ps(value); }
+    static Int SetI(int value) { return _mm_set1_epi32(value); }
+    static Int LaneIndices() { return _mm_setr_epi32(0, 1, 2, 3); }
+
+    static Float Add(Float a, Float b) { return _mm_add_ps(a, b); }
+    static Float Sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+    static Float Mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+    static Float And(Float mask, Float value) { return _mm_and_ps(mask, value); }
+    static Float Less(Float a, Float b) { return _mm_cmplt_ps(a, b); }
+    static Float Greater(Float a, Float b) { return _mm_cmpgt_ps(a, b); }
+    static Float Select(Float mask, Float a, Float b) { return _mm_blendv_ps(b, a, mask); }
+
+    static Int AddI(Int a, Int b) { return _mm_add_epi32(a, b); }
+    static Int MulI(Int a, Int b) { return _mm_mullo_epi32(a, b); }
+    static Int XorI(Int a, Int b) { return _mm_xor_si128(a, b); }
+    static Int AndI(Int a, Int b) { return _mm_and_si128(a, b); }
+    template <int Shift>
+    static Int ShiftRightI(Int a) {
+        return _mm_srai_epi32(a, Shift);
+    }
+    static Int SelectI(Int mask, Int a, Int b) { return _mm_blendv_epi8(b, a, mask); }
+
+    static Float ToFloat(Int a) { return _mm_cvtepi32_ps(a); }
+    static Int Truncate(Float a) { return _mm_cvttps_epi32(a); }
+    static Int MaskToInt(Float mask) { return _mm_castps_si128(mask); }  // All ones, -1, in the selected lanes
+
+    // No gather before AVX2
+    static Float Gather(const float* table, Int indices) {
+        alignas(16) int lanes[WIDTH];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), indices);
+        return _mm_setr_ps(table[lanes[0]], table[lanes[1]], table[lanes[2]], table[lanes[3]]);
+    }
+
+    static void Store(float* out, Float value) { _mm_storeu_ps(out, value); }
+};
+
+void GenerateNoiseRowSSE41(int seed, float frequency, int originX, int z, int width, float* out) {
+    NoiseKernel::GenerateRow<SSE41>(seed, frequency, originX, z, width, out);
+}
+#endif
@@ -0,0 +1,60 @@
+#include "PhysicsSystem.h"
+
+#include "CollisionManager.h"
+#include "EntityStore.h"
+#include "core/ThreadPool.h"
+#include "pch.h"
+#include "utils/Profiler.h"
+
+PhysicsSystem::PhysicsSystem(EntityStore& store, const CollisionManager& collisionManager)
+    : m_Store(store), m_CollisionManager(collisionManager), m_NbEntityCollisions(0) {}
+
+void PhysicsSystem::Update(float dt) {
+    PROFILE_SCOPE("PhysicsSystem::Update");
+
+    ThreadPool::Get().ParallelFor(m_Store.GetSize(), PHYSICS_BATCH_SIZE, [this, dt](size_t begin, size_t end) { UpdateRange(begin, end, dt); });
+
+    m_Broadphase.Update(m_Store);
+    m_Broadphase.FindPairs(m_Pairs);
+    SeparateEntities();
+}
+
+void PhysicsSystem::UpdateRange(size_t begin, size_t end, float dt) {
+    thread_local std::vector<Box> candidates;  // Per thread scratch buffer, keeps its capacity between steps
+
+    auto& velocities = m_Store.GetVelocities();
+    const auto& gravities = m_Store.GetGravities();
+    for (size_t i = begin; i < end; i++) {
+        velocities[i].y -= gravities[i] * dt;
+        m_CollisionManager.Sweep(m_Store, i, dt, candidates);
+    }
+}
+
+void PhysicsSystem::SeparateEntities() {
+    PROFILE_SCOPE("PhysicsSystem::SeparateEntities");
+
+    auto& boxes = m_Store.GetBoxes();
+    m_NbEntityCollisions = 0;
+
+    for (const auto& [idA, idB] : m_Pairs) {
+        size_t a = m_Store.GetIndex(idA);
+        size_t b = m_Store.GetIndex(idB);
+        if (!boxes[a].Intersects(boxes[b])) continue;
+        m_NbEntityCollisions++;
+
+        // Push both entities apart by half the overlap on the horizontal axis that overlaps the least,
+        // through the collision manager so that nobody gets pushed into a voxel
+        float overlapX = std::min(boxes[a].max.x, boxes[b].max.x) - std::max(boxes[a].min.x, boxes[b].min.x);
+        float overlapZ = std::min(boxes[a].max.z, boxes[b].max.z) - std::max(boxes[a].min.z, boxes[b].min.z);
+        int axis = overlapX < overlapZ ? 0 : 2;
+        float overlap = axis == 0 ? overlapX : overlapZ;
+        if (overlap <= 0.0f) continue;
+
+        float direction = (boxes[a].min[axis] + boxes[a].max[axis]) < (boxes[b].min[axis] + boxes[b].max[axis]) ? -1.0f : 1.0f;
+        glm::vec3 push(0.0f);
+        push[axis] = direction * overlap * 0.5f;
+
+        m_CollisionManager.Move(m_Store, a, push, m_Candidates);
+        m_CollisionManager.Move(m_Store, b, -push, m_Candidates);
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef __PHYSICS_SYSTEM_H__
+#define __PHYSICS_SYSTEM_H__
+
+#include <cstddef>
+#include <vector>
+
+#include "EntityBroadphase.h"
+#include "utils/Box.h"
+
+class EntityStore;
+class CollisionManager;
+
+// Entities handled by a single thread pool job
+constexpr size_t PHYSICS_BATCH_SIZE = 256;
+
+// Integrates every entity of the store, batches of entities are spread over the thread pool
+class PhysicsSystem {
+   public:
+    PhysicsSystem(EntityStore& store, const CollisionManager& collisionManager);
+
+    void Update(float dt);
+
+    /* Getters */
+    size_t GetNbPairsTested() const { return m_Pairs.size(); }
+    size_t GetNbEntityCollisions() const { return m_NbEntityCollisions; }
+
+   private:
+    EntityStore& m_Store;
+    const CollisionManager& m_CollisionManager;
+    EntityBroadphase m_Broadphase;
+    std::vector<EntityPair> m_Pairs;
+    std::vector<Box> m_Candidates;
+    size_t m_NbEntityCollisions;
+
+    void UpdateRange(size_t begin, size_t end, float dt);
+    void SeparateEntities();
+};
+
+#endif  // __PHYSICS_SYSTEM_H__
@@ -1,6 +1,7 @@
 #ifndef __PLAYER_H__
 #define __PLAYER_H__
 
+#include <atomic>
 #include <glm/glm.hpp>
 #include <memory>
 
@@ -12,26 +13,37 @@ constexpr int PLAYER_JUMP_STRENGTH = 10.0f;
 
 class Event;
 
+// Movement wanted by the player, sampled once per frame and consumed by every physics step
+struct PlayerInput {
+    glm::vec3 direction;  // Horizontal direction, normalized or null
+    bool jump;
+    bool descend;
+
+    PlayerInput() : direction(glm::vec3(0.0f)), jump(false), descend(false) {}
+};
+
 class Player : public Entity {
    public:
-    Player();
+    Player(EntityStore& store);
 
     void Init();
+    void HandleInput();  // Sample keyboard and camera, must run on the main thread
     void Update(float dt = Time::Get().GetDeltaTime()) override;
-    void Move(const glm::vec3& delta) override;
+    void Teleport(const glm::vec3& position);
+    // Place the camera at eye level, alpha interpolates between the last two physics steps
+    void SyncCamera(float alpha = 1.0f);
 
     void OnEvent(const Event& event);
 
-    /* Setters */
-    void SetPosition(const glm::vec3& position) override;
-
     /* Getters */
     const Camera& GetCamera() const { return m_Camera; }
     Camera& GetCamera() { return m_Camera; }
 
    private:
-    bool m_GodMode;
+    std::atomic<bool> m_GodMode;  // Set by events on the main thread, read by the physics step
     Camera m_Camera;
+    PlayerInput m_Input;
+    glm::vec3 m_PreviousPosition;  // Position before the last physics step
 };
 
 #endif  // __PLAYER_H__
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "RegionCache.h"
+
+#include "pch.h"
+#include "utils/Profiler.h"
+
+RegionCache::RegionCache(const Noise& noise, size_t capacity)
+    : m_HeightNoise(noise),
+      m_TemperatureNoise(noise.GetSeed() + 1, CLIMATE_FREQUENCY),
+      m_HumidityNoise(noise.GetSeed() + 2, CLIMATE_FREQUENCY),
+      m_Capacity(capacity),
+      m_NbGenerated(0) {}
+
+glm::ivec2 RegionCache::ToRegionCoord(int worldX, int worldZ) {
+    // Floor division, negative columns belong to the region below
+    auto floorDiv = [](int value) { return (value >= 0 ? value : value - REGION_WIDTH + 1) / REGION_WIDTH; };
+    return glm::ivec2(floorDiv(worldX), floorDiv(worldZ));
+}
+
+std::shared_ptr<const Region> RegionCache::GetRegion(int worldX, int worldZ) {
+    const glm::ivec2 regionCoord = ToRegionCoord(worldX, worldZ);
+
+    std::promise<std::shared_ptr<const Region>> promise;
+    std::shared_future<std::shared_ptr<const Region>> region;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_Regions.find(regionCoord);
+        if (it != m_Regions.end()) {
+            m_LRU.splice(m_LRU.begin(), m_LRU, it->second.lruPosition);  // Hit: move to the front
+            region = it->second.region;
+        } else {
+            m_LRU.push_front(regionCoord);
+            m_Regions[regionCoord] = {promise.get_future().share(), m_LRU.begin()};
+            m_NbGenerated++;
+
+            Evict();
+        }
+    }
+
+    if (region.valid()) return region.get();  // Waits if another thread is still generating it
+
+    auto generated = Generate(regionCoord);
+    promise.set_value(generated);
+    return generated;
+}
+
+std::shared_ptr<const Region> RegionCache::Generate(const glm::ivec2& regionCoord) const {
+    PROFILE_SCOPE("RegionCache::Generate");
+
+    auto region = std::make_shared<Region>();
+    region->origin = regionCoord * REGION_WIDTH;
+    m_HeightNoise.GenerateTile(region->origin.x, region->origin.y, REGION_WIDTH, REGION_WIDTH, region->height.data());
+    m_TemperatureNoise.GenerateTile(region->origin.x, region->origin.y, REGION_WIDTH, REGION_WIDTH, region->temperature.data());
+    m_HumidityNoise.GenerateTile(region->origin.x, region->origin.y, REGION_WIDTH, REGION_WIDTH, region->humidity.data());
+    return region;
+}
+
+size_t RegionCache::GetSize() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Regions.size();
+}
+
+size_t RegionCache::GetCapacity() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Capacity;
+}
+
+void RegionCache::SetCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Capacity = capacity;
+    Evict();
+}
+
+void RegionCache::Evict() {
+    // Evicted regions stay alive while a chunk job still holds them
+    while (m_Regions.size() > m_Capacity) {
+        m_Regions.erase(m_LRU.back());
+        m_LRU.pop_back();
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef __REGION_CACHE_H__
+#define __REGION_CACHE_H__
+
+#include <array>
+#include <atomic>
+#include <future>
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "Chunk.h"
+#include "Noise.h"
+
+constexpr int REGION_SIZE = 8;                                    // Chunks per region side
+constexpr int REGION_WIDTH = REGION_SIZE * CHUNK_WIDTH;           // Columns per region side
+constexpr int NB_COLUMNS_IN_REGION = REGION_WIDTH * REGION_WIDTH;
+constexpr size_t REGION_CACHE_CAPACITY = 64;                      // Regions kept by default, ChunkManager sizes its own
+constexpr float CLIMATE_FREQUENCY = 0.002f;                       // Climate varies over hundreds of blocks
+
+// 2D maps of a REGION_WIDTH x REGION_WIDTH column area, generated once and shared by its chunks
+struct Region {
+    glm::ivec2 origin;  // World x/z of the first column
+
+    // Indexed [z * REGION_WIDTH + x], raw noise in -1...1
+    std::array<float, NB_COLUMNS_IN_REGION> height;
+    std::array<float, NB_COLUMNS_IN_REGION> temperature;
+    std::array<float, NB_COLUMNS_IN_REGION> humidity;
+
+    // Height noise of the column at world x/z, which must lie in the region
+    const float* GetHeightRow(int worldX, int worldZ) const { return &height[(worldZ - origin.y) * REGION_WIDTH + (worldX - origin.x)]; }
+};
+
+// Thread safe LRU cache of regions. The first chunk job that needs a region generates it, the others wait for that one.
+class RegionCache {
+   public:
+    RegionCache(const Noise& noise, size_t capacity = REGION_CACHE_CAPACITY);
+
+    // Region holding the column at world x/z, generated on the calling thread on a miss
+    std::shared_ptr<const Region> GetRegion(int worldX, int worldZ);
+
+    static glm::ivec2 ToRegionCoord(int worldX, int worldZ);
+
+    /* Getters */
+    size_t GetSize() const;
+    size_t GetCapacity() const;
+    size_t GetNbGenerated() const { return m_NbGenerated.load(std::memory_order_relaxed); }  // Misses since the start, evicted regions included
+    const Noise& GetNoise() const { return m_HeightNoise; }
+
+    /* Setters */
+    void SetCapacity(size_t capacity);  // Evicts the least recently used regions past it
+
+   private:
+    std::shared_ptr<const Region> Generate(const glm::ivec2& regionCoord) const;
+    void Evict();  // Under the lock
+
+    struct Entry {
+        std::shared_future<std::shared_ptr<const Region>> region;  // Ready once the generating thread is done
+        std::list<glm::ivec2>::iterator lruPosition;
+    };
+
+    // Immutable after construction, so worker threads read them without locking
+    const Noise m_HeightNoise;
+    const Noise m_TemperatureNoise;
+    const Noise m_HumidityNoise;
+
+    mutable std::mutex m_Mutex;
+    std::unordered_map<glm::ivec2, Entry> m_Regions;
+    std::list<glm::ivec2> m_LRU;  // Most recently used first
+    size_t m_Capacity;
+    std::atomic<size_t> m_NbGenerated;  // Counted by the workers under the lock, read by anyone
+};
+
+#endif  // __REGION_CACHE_H__
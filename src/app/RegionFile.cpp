@@ -0,0 +1,189 @@
+#include "RegionFile.h"
+
+#include "ChunkCodec.h"
+#include "pch.h"
+#include "utils/Logger.h"
+#include "utils/Profiler.h"
+
+static void WriteU32(uint8_t* out, uint32_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+    out[2] = static_cast<uint8_t>(value >> 16);
+    out[3] = static_cast<uint8_t>(value >> 24);
+}
+
+static uint32_t ReadU32(const uint8_t* in) {
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) | (static_cast<uint32_t>(in[2]) << 16) |
+           (static_cast<uint32_t>(in[3]) << 24);
+}
+
+RegionFile::RegionFile(const std::string& path) : m_Path(path), m_Entries(), m_FileSize(0), m_DeadBytes(0) {}
+
+std::unique_ptr<RegionFile> RegionFile::Open(const std::string& path, bool create) {
+    std::unique_ptr<RegionFile> file(new RegionFile(path));
+
+    std::error_code error;
+    if (!std::filesystem::exists(path, error)) {
+        if (!create || !file->Create()) return nullptr;
+    }
+    if (!file->Load()) return nullptr;
+    return file;
+}
+
+bool RegionFile::Create() {
+    std::vector<uint8_t> header(REGION_FILE_HEADER_SIZE, 0);
+    WriteU32(&header[0], REGION_FILE_MAGIC);
+    WriteU32(&header[4], REGION_FILE_VERSION);
+
+    std::ofstream stream(m_Path, std::ios::binary | std::ios::trunc);
+    stream.write(reinterpret_cast<const char*>(header.data()), header.size());
+    if (!stream) {
+        LOG_ERROR("Region file \'{0}\' cannot be created", m_Path);
+        return false;
+    }
+    return true;
+}
+
+bool RegionFile::Load() {
+    if (!m_Mapping.Map(m_Path) || m_Mapping.GetSize() < REGION_FILE_HEADER_SIZE) {
+        LOG_ERROR("Region file \'{0}\' cannot be mapped or is truncated", m_Path);
+        return false;
+    }
+
+    const uint8_t* data = m_Mapping.GetData();
+    if (ReadU32(data) != REGION_FILE_MAGIC || ReadU32(data + 4) != REGION_FILE_VERSION) {
+        LOG_ERROR("\'{0}\' is not a version {1} region file", m_Path, REGION_FILE_VERSION);
+        return false;
+    }
+
+    m_FileSize = m_Mapping.GetSize();
+    size_t liveBytes = 0;
+    for (int i = 0; i < NB_CHUNKS_IN_REGION_FILE; i++) {
+        Entry entry = {ReadU32(data + 8 + i * 8), ReadU32(data + 12 + i * 8)};
+        if (entry.offset != 0 && (entry.offset < REGION_FILE_HEADER_SIZE || static_cast<size_t>(entry.offset) + entry.size > m_FileSize)) {
+            LOG_WARNING("Region file \'{0}\': chunk {1} points outside the file, it will be regenerated", m_Path, i);
+            entry = {0, 0};
+        }
+        m_Entries[i] = entry;
+        liveBytes += entry.size;
+    }
+    m_DeadBytes = m_FileSize - REGION_FILE_HEADER_SIZE - liveBytes;
+
+    m_Stream.open(m_Path, std::ios::in | std::ios::out | std::ios::binary);
+    if (!m_Stream.is_open()) {
+        LOG_ERROR("Region file \'{0}\' cannot be opened for writing", m_Path);
+        return false;
+    }
+    return true;
+}
+
+bool RegionFile::ReadChunk(int index, BlockArray& blocks) const {
+    {
+        std::shared_lock<std::shared_mutex> lock(m_Mutex);
+        const Entry& entry = m_Entries[index];
+        if (entry.offset == 0) return false;
+        if (IsMapped(entry)) return ChunkCodec::Decode(m_Mapping.GetData() + entry.offset, entry.size, blocks);
+    }
+
+    // Written since the last mapping, the first reader to need it maps the file again
+    std::unique_lock<std::shared_mutex> lock(m_Mutex);
+    const Entry& entry = m_Entries[index];
+    if (entry.offset == 0) return false;
+    if (!IsMapped(entry) && (!Remap() || !IsMapped(entry))) return false;
+    return ChunkCodec::Decode(m_Mapping.GetData() + entry.offset, entry.size, blocks);
+}
+
+bool RegionFile::WriteChunk(int index, const std::vector<uint8_t>& payload) {
+    // Payload first, then its table entry: an interrupted write leaves the previous version in place
+    const size_t offset = m_FileSize;
+    uint8_t entry[8];
+    WriteU32(entry, static_cast<uint32_t>(offset));
+    WriteU32(entry + 4, static_cast<uint32_t>(payload.size()));
+
+    m_Stream.seekp(offset);
+    m_Stream.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+    m_Stream.seekp(8 + index * 8);
+    m_Stream.write(reinterpret_cast<const char*>(entry), sizeof(entry));
+    m_Stream.flush();
+    if (!m_Stream) {
+        LOG_ERROR("Region file \'{0}\': writing chunk {1} failed", m_Path, index);
+        m_Stream.clear();
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_Mutex);
+    m_DeadBytes += m_Entries[index].size;
+    m_Entries[index] = {static_cast<uint32_t>(offset), static_cast<uint32_t>(payload.size())};
+    m_FileSize += payload.size();
+    return true;
+}
+
+bool RegionFile::NeedsCompaction() const {
+    const size_t liveBytes = m_FileSize - REGION_FILE_HEADER_SIZE - m_DeadBytes;
+    return m_DeadBytes > REGION_FILE_COMPACT_THRESHOLD && m_DeadBytes > liveBytes;
+}
+
+bool RegionFile::Compact() {
+    PROFILE_SCOPE("RegionFile::Compact");
+
+    std::unique_lock<std::shared_mutex> lock(m_Mutex);
+    if (m_Mapping.GetSize() < m_FileSize && !Remap()) return false;  // The payloads are copied from the mapping
+
+    // Live payloads packed after the header, in a new file swapped in once complete
+    std::array<Entry, NB_CHUNKS_IN_REGION_FILE> entries;
+    std::vector<uint8_t> header(REGION_FILE_HEADER_SIZE, 0);
+    WriteU32(&header[0], REGION_FILE_MAGIC);
+    WriteU32(&header[4], REGION_FILE_VERSION);
+    size_t offset = REGION_FILE_HEADER_SIZE;
+    for (int i = 0; i < NB_CHUNKS_IN_REGION_FILE; i++) {
+        entries[i] = m_Entries[i].offset != 0 ? Entry{static_cast<uint32_t>(offset), m_Entries[i].size} : Entry{0, 0};
+        WriteU32(&header[8 + i * 8], entries[i].offset);
+        WriteU32(&header[12 + i * 8], entries[i].size);
+        offset += entries[i].size;
+    }
+
+    const std::string compactedPath = m_Path + ".tmp";
+    {
+        std::ofstream stream(compactedPath, std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<const char*>(header.data()), header.size());
+        for (const Entry& entry : m_Entries) {
+            if (entry.offset != 0) stream.write(reinterpret_cast<const char*>(m_Mapping.GetData() + entry.offset), entry.size);
+        }
+        if (!stream) {
+            LOG_ERROR("Region file \'{0}\' cannot be compacted", m_Path);
+            std::error_code error;
+            std::filesystem::remove(compactedPath, error);
+            return false;
+        }
+    }
+
+    // Nothing may keep the old file open while it is replaced
+    m_Stream.close();
+    m_Mapping.Unmap();
+    std::error_code error;
+    std::filesystem::rename(compactedPath, m_Path, error);
+    if (error) {
+        LOG_ERROR("Region file \'{0}\' cannot be replaced by its compacted version: {1}", m_Path, error.message());
+    } else {
+        m_Entries = entries;
+        m_FileSize = offset;
+        m_DeadBytes = 0;
+    }
+
+    m_Stream.open(m_Path, std::ios::in | std::ios::out | std::ios::binary);
+    return Remap() && !error;
+}
+
+bool RegionFile::Remap() const {
+    if (!m_Mapping.Map(m_Path)) {
+        LOG_ERROR("Region file \'{0}\' cannot be mapped", m_Path);
+        return false;
+    }
+    return true;
+}
+
+int RegionFile::ToChunkIndex(int chunkX, int chunkZ) {
+    const int x = ((chunkX % REGION_FILE_WIDTH) + REGION_FILE_WIDTH) % REGION_FILE_WIDTH;
+    const int z = ((chunkZ % REGION_FILE_WIDTH) + REGION_FILE_WIDTH) % REGION_FILE_WIDTH;
+    return x + z * REGION_FILE_WIDTH;
+}
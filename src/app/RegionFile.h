@@ -0,0 +1,70 @@
+#ifndef __REGION_FILE_H__
+#define __REGION_FILE_H__
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "Chunk.h"
+#include "utils/MappedFile.h"
+
+constexpr int REGION_FILE_WIDTH = 32;  // Chunks per region file side
+constexpr int NB_CHUNKS_IN_REGION_FILE = REGION_FILE_WIDTH * REGION_FILE_WIDTH;
+constexpr uint32_t REGION_FILE_MAGIC = 0x47525856;  // "VXRG"
+constexpr uint32_t REGION_FILE_VERSION = 1;
+constexpr size_t REGION_FILE_HEADER_SIZE = 8 + NB_CHUNKS_IN_REGION_FILE * 8;
+constexpr size_t REGION_FILE_COMPACT_THRESHOLD = 64 * 1024;  // Dead bytes tolerated before compacting, when they also outweigh the live ones
+
+// One file of REGION_FILE_WIDTH x REGION_FILE_WIDTH chunks:
+//   u32 magic | u32 version | offset table: u32 offset, u32 size per chunk (offset 0 when absent) | ChunkCodec payloads
+// All integers are little endian. A rewritten chunk is appended and its entry updated, the old payload becomes dead bytes
+// until the file is compacted. Reads go through a memory mapping and can run on any thread, writes on a single one.
+// Writes leave the mapping as is, the first read past its end maps the grown file again.
+class RegionFile {
+   public:
+    // nullptr when the file does not exist and create is false, or when it is not a valid region file
+    static std::unique_ptr<RegionFile> Open(const std::string& path, bool create);
+
+    // Decodes the chunk at index (x + z * REGION_FILE_WIDTH), false when absent or corrupted
+    bool ReadChunk(int index, BlockArray& blocks) const;
+
+    // Writer thread only
+    bool WriteChunk(int index, const std::vector<uint8_t>& payload);
+    bool NeedsCompaction() const;
+    bool Compact();
+
+    static int ToChunkIndex(int chunkX, int chunkZ);  // Index of a chunk, in world chunk coordinates, inside its file
+
+    /* Getters */
+    const std::string& GetPath() const { return m_Path; }
+    size_t GetFileSize() const { return m_FileSize; }
+    size_t GetDeadBytes() const { return m_DeadBytes; }
+
+   private:
+    struct Entry {
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    RegionFile(const std::string& path);
+
+    bool Load();
+    bool Create();
+    bool Remap() const;  // Exclusive lock held
+    bool IsMapped(const Entry& entry) const { return static_cast<size_t>(entry.offset) + entry.size <= m_Mapping.GetSize(); }
+
+    std::string m_Path;
+    std::fstream m_Stream;  // Writes only
+
+    mutable std::shared_mutex m_Mutex;  // Readers share it, table updates and remaps take it exclusively
+    mutable MappedFile m_Mapping;       // Reads only, remapped by the reader that needs the grown file
+    std::array<Entry, NB_CHUNKS_IN_REGION_FILE> m_Entries;
+    size_t m_FileSize;
+    size_t m_DeadBytes;
+};
+
+#endif  // __REGION_FILE_H__
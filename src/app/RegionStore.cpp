@@ -0,0 +1,107 @@
+#include "RegionStore.h"
+
+#include "ChunkCodec.h"
+#include "pch.h"
+#include "utils/Logger.h"
+#include "utils/Profiler.h"
+
+RegionStore::RegionStore(const std::string& directory) : m_Directory(directory), m_NextSequence(0), m_Stop(false) {
+    std::error_code error;
+    std::filesystem::create_directories(m_Directory, error);
+    if (error) LOG_ERROR("World directory \'{0}\' cannot be created: {1}", m_Directory, error.message());
+
+    m_Writer = std::thread(&RegionStore::WriterLoop, this);
+}
+
+RegionStore::~RegionStore() {
+    {
+        std::lock_guard<std::mutex> lock(m_PendingMutex);
+        m_Stop = true;
+    }
+    m_PendingCondition.notify_one();
+    m_Writer.join();
+}
+
+bool RegionStore::Load(const glm::ivec2& chunkCoord, BlockArray& blocks) {
+    PROFILE_SCOPE("RegionStore::Load");
+
+    {
+        std::lock_guard<std::mutex> lock(m_PendingMutex);
+        auto it = m_Pending.find(chunkCoord);
+        if (it != m_Pending.end()) return ChunkCodec::Decode(it->second.payload.data(), it->second.payload.size(), blocks);
+    }
+
+    RegionFile* file = GetFile(ToFileCoord(chunkCoord), false);
+    return file != nullptr && file->ReadChunk(RegionFile::ToChunkIndex(chunkCoord.x, chunkCoord.y), blocks);
+}
+
+void RegionStore::Save(const glm::ivec2& chunkCoord, const BlockArray& blocks) {
+    std::vector<uint8_t> payload;
+    ChunkCodec::Encode(blocks, payload);
+    Save(chunkCoord, std::move(payload));
+}
+
+void RegionStore::Save(const glm::ivec2& chunkCoord, std::vector<uint8_t> payload) {
+    {
+        std::lock_guard<std::mutex> lock(m_PendingMutex);
+        m_Pending[chunkCoord] = {std::move(payload), m_NextSequence++};
+    }
+    m_PendingCondition.notify_one();
+}
+
+void RegionStore::Flush() {
+    std::unique_lock<std::mutex> lock(m_PendingMutex);
+    m_FlushedCondition.wait(lock, [this] { return m_Pending.empty(); });
+}
+
+glm::ivec2 RegionStore::ToFileCoord(const glm::ivec2& chunkCoord) {
+    // Floor division, negative chunks belong to the file below
+    auto floorDiv = [](int value) { return (value >= 0 ? value : value - REGION_FILE_WIDTH + 1) / REGION_FILE_WIDTH; };
+    return glm::ivec2(floorDiv(chunkCoord.x), floorDiv(chunkCoord.y));
+}
+
+RegionFile* RegionStore::GetFile(const glm::ivec2& fileCoord, bool create) {
+    std::lock_guard<std::mutex> lock(m_FilesMutex);
+
+    auto it = m_Files.find(fileCoord);
+    if (it != m_Files.end() && (it->second != nullptr || !create)) return it->second.get();
+
+    auto& file = m_Files[fileCoord];
+    file = RegionFile::Open(GetFilePath(fileCoord), create);
+    return file.get();
+}
+
+std::string RegionStore::GetFilePath(const glm::ivec2& fileCoord) const {
+    return (std::filesystem::path(m_Directory) / std::format("r.{0}.{1}.vxr", fileCoord.x, fileCoord.y)).string();
+}
+
+void RegionStore::WriterLoop() {
+    Profiler::SetThreadName("Region writer");
+
+    std::unique_lock<std::mutex> lock(m_PendingMutex);
+    while (true) {
+        m_PendingCondition.wait(lock, [this] { return m_Stop || !m_Pending.empty(); });
+        if (m_Pending.empty()) return;  // Stopping with nothing left to write
+
+        // Written outside the lock, a newer save of the same chunk keeps it pending
+        auto it = m_Pending.begin();
+        const glm::ivec2 chunkCoord = it->first;
+        const uint64_t sequence = it->second.sequence;
+        const std::vector<uint8_t> payload = it->second.payload;
+        lock.unlock();
+
+        {
+            PROFILE_SCOPE("RegionStore::Write");
+            RegionFile* file = GetFile(ToFileCoord(chunkCoord), true);
+            if (file != nullptr) {
+                file->WriteChunk(RegionFile::ToChunkIndex(chunkCoord.x, chunkCoord.y), payload);
+                if (file->NeedsCompaction()) file->Compact();
+            }
+        }
+
+        lock.lock();
+        it = m_Pending.find(chunkCoord);
+        if (it != m_Pending.end() && it->second.sequence == sequence) m_Pending.erase(it);
+        if (m_Pending.empty()) m_FlushedCondition.notify_all();
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef __REGION_STORE_H__
+#define __REGION_STORE_H__
+
+#include <condition_variable>
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Chunk.h"
+#include "RegionFile.h"
+
+// Saved chunks of a world, one RegionFile per REGION_FILE_WIDTH x REGION_FILE_WIDTH chunks in a directory.
+// Loads run on the calling thread; saves are encoded there and written by a background writer thread.
+class RegionStore {
+   public:
+    RegionStore(const std::string& directory);
+    ~RegionStore();  // Writes what is still pending
+
+    // Chunk coordinates as in ChunkManager, false when the chunk was never saved
+    bool Load(const glm::ivec2& chunkCoord, BlockArray& blocks);
+    void Save(const glm::ivec2& chunkCoord, const BlockArray& blocks);
+    void Save(const glm::ivec2& chunkCoord, std::vector<uint8_t> payload);  // Already encoded with ChunkCodec
+
+    // Blocks until every save queued so far is on disk
+    void Flush();
+
+    static glm::ivec2 ToFileCoord(const glm::ivec2& chunkCoord);
+
+    /* Getters */
+    const std::string& GetDirectory() const { return m_Directory; }
+
+   private:
+    RegionFile* GetFile(const glm::ivec2& fileCoord, bool create);
+    std::string GetFilePath(const glm::ivec2& fileCoord) const;
+    void WriterLoop();
+
+    std::string m_Directory;
+
+    std::mutex m_FilesMutex;
+    std::unordered_map<glm::ivec2, std::unique_ptr<RegionFile>> m_Files;  // nullptr for files known to be missing
+
+    struct PendingSave {
+        std::vector<uint8_t> payload;
+        uint64_t sequence;  // A save replaced while being written stays pending
+    };
+
+    // Latest payload per chunk until it is on disk, also served to Load so a chunk reads back what was saved
+    std::mutex m_PendingMutex;
+    std::condition_variable m_PendingCondition;
+    std::condition_variable m_FlushedCondition;
+    std::unordered_map<glm::ivec2, PendingSave> m_Pending;
+    uint64_t m_NextSequence;
+    bool m_Stop;
+    std::thread m_Writer;
+};
+
+#endif  // __REGION_STORE_H__
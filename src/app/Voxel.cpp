@@ -1,9 +1,5 @@
 #include "Voxel.h"
 
-#include "gfx/Buffer.h"
-#include "gfx/GraphicContext.h"
-#include "gfx/Shader.h"
-#include "gfx/VertexArray.h"
 #include "pch.h"
 
 Voxel::Voxel(glm::vec3 position)
@@ -0,0 +1,16 @@
+#ifndef __VOXEL_GRID_H__
+#define __VOXEL_GRID_H__
+
+#include <glm/glm.hpp>
+
+class Voxel;
+
+// Pure virtual class for anything that can answer voxel queries in world space
+class VoxelGrid {
+   public:
+    virtual ~VoxelGrid() = default;
+
+    virtual Voxel* GetVoxel(const glm::vec3& pos) const = 0;
+};
+
+#endif  // __VOXEL_GRID_H__
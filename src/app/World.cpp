@@ -2,61 +2,130 @@
 
 #include "Chunk.h"
 #include "CollisionManager.h"
+#include "core/KeyCodes.h"
 #include "core/ThreadPool.h"
 #include "events/EventApplication.h"
 #include "events/EventDispatcher.h"
 #include "events/EventKeyboard.h"
-#include "gfx/GraphicContext.h"
 #include "gfx/Renderable.h"
-#include "gfx/Shader.h"
 #include "pch.h"
+#include "utils/Logger.h"
+#include "utils/Profiler.h"
 #include "utils/Time.h"
 
 WorldStatus World::m_Status;
 
-World::World() : m_IsPaused(false), m_LastPlayerPos(glm::vec3(0.0f)), m_CollisionManager(*this) {}
+World::World()
+    : m_IsPaused(false),
+      m_Player(m_EntityStore),
+      m_CollisionManager(*this),
+      m_PhysicsSystem(m_EntityStore, m_CollisionManager),
+      m_LastPlayerPos(glm::vec3(0.0f)),
+      m_Accumulator(0.0),
+      m_PhysicsThreaded(false) {}
 
-World::~World() {}
+World::~World() { SetPhysicsThreaded(false); }
 
-void World::Init() {
+void World::Init(const std::string& savePath) {
     EventDispatcher::Get().Subscribe(EventCategory::EventCategoryAll, BIND_EVENT_FN(World::OnEvent));
     m_Player.Init();
-    m_Player.Move(glm::vec3(0, CHUNK_HEIGHT, 0));
+    m_Player.Teleport(glm::vec3(0, CHUNK_HEIGHT, 0));
     m_LastPlayerPos = m_Player.GetPosition();
-    m_ChunkManager.Init();
+    m_ChunkManager.Init(savePath);
 }
 
 void World::Update() {
+    // Outside of the physics lock: the chunk map only changes in SetCenter, steps need not wait for the meshing dispatch
     m_ChunkManager.Update();
 
     if (m_IsPaused) return;
+    std::unique_lock<std::mutex> lock(m_PhysicsMutex);
 
     m_LastPlayerPos = m_Player.GetPosition();
+    m_Player.HandleInput();
+
+    float alpha;
+    if (m_PhysicsThreaded) {
+        // The physics thread steps on its own clock, only interpolate toward its last step
+        double sinceLastStep = std::chrono::duration<double>(Clock::now() - m_LastStepTime).count();
+        alpha = static_cast<float>(std::min(sinceLastStep / PHYSICS_STEP, 1.0));
+    } else {
+        m_Accumulator += Time::Get().GetDeltaTime();
+
+        int nbSteps = 0;
+        while (m_Accumulator >= PHYSICS_STEP && nbSteps < PHYSICS_MAX_STEPS) {
+            Step();
+            m_Accumulator -= PHYSICS_STEP;
+            nbSteps++;
+        }
+        // Too far behind after a hitch, drop the time left instead of spiralling
+        if (nbSteps == PHYSICS_MAX_STEPS) m_Accumulator = std::fmod(m_Accumulator, static_cast<double>(PHYSICS_STEP));
 
-    float dt = std::min({static_cast<float>(Time::Get().GetDeltaTime()), PHYSICS_STEP});
-    int nbSteps = static_cast<float>(Time::Get().GetDeltaTime()) / dt;
-
-    for (uint8_t i = 0; i < nbSteps; i++) {
-        m_Player.Update(dt);
-        m_CollisionManager.Update();
+        alpha = static_cast<float>(m_Accumulator / PHYSICS_STEP);
     }
+    m_Player.SyncCamera(alpha);
 
     m_Player.GetCamera().Update();
 
-    glm::ivec3 chunkPos = m_ChunkManager.ToChunkCoord(m_Player.GetPosition());
-    glm::ivec3 lastChunkPos = m_ChunkManager.ToChunkCoord(m_LastPlayerPos);
-    if (chunkPos != lastChunkPos) {
-        LOG_TRACE("NEED TO UPDATE WORLD");
-    }
+    // Compared with the current center rather than the last frame, the physics thread may move the player in between.
+    // Under the physics lock, steps read the chunk map. The camera picks the LOD rings, it follows the player
+    m_ChunkManager.SetCenter(m_ChunkManager.ToChunkCoord(m_Player.GetCamera().GetPosition()));
+    m_Status.playerPos = m_Player.GetPosition();
+    lock.unlock();
 
     // Update status
-    m_Status.playerPos = m_Player.GetPosition();
+    m_Status.nbLoadedChunks = m_ChunkManager.GetNbLoadedChunks();
+    m_Status.nbColdChunks = m_ChunkManager.GetColdChunks().GetSize();
+    m_Status.coldChunksBytes = m_ChunkManager.GetColdChunks().GetBytes();
+    m_Status.nbLodTiles = m_ChunkManager.GetNbLodTiles();
+    m_Status.ringTriangles = m_ChunkManager.GetRingTriangles();
+    m_Status.farTerrainTriangles = m_ChunkManager.GetFarTerrain().GetNbTriangles();
+}
+
+void World::Step() {
+    PROFILE_SCOPE("World::Step");
+
+    m_Player.Update(PHYSICS_STEP);
+    m_PhysicsSystem.Update(PHYSICS_STEP);
+    m_LastStepTime = Clock::now();
+}
+
+void World::PhysicsThreadLoop() {
+    const auto step = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(PHYSICS_STEP));
+    auto nextStep = Clock::now();
+
+    while (m_PhysicsThreaded) {
+        {
+            std::lock_guard<std::mutex> lock(m_PhysicsMutex);
+            if (!m_IsPaused) Step();
+        }
+
+        nextStep += step;
+        if (Clock::now() - nextStep > step * PHYSICS_MAX_STEPS) nextStep = Clock::now();  // Fell too far behind, drop the lost time
+        std::this_thread::sleep_until(nextStep);
+    }
+}
+
+void World::SetPhysicsThreaded(bool threaded) {
+    if (threaded == m_PhysicsThreaded) return;
+
+    if (threaded) {
+        m_LastStepTime = Clock::now();
+        m_PhysicsThreaded = true;
+        m_PhysicsThread = std::thread(&World::PhysicsThreadLoop, this);
+        LOG_INFO("Physics running on its own thread");
+    } else {
+        m_PhysicsThreaded = false;
+        if (m_PhysicsThread.joinable()) m_PhysicsThread.join();
+        m_Accumulator = 0.0;
+        LOG_INFO("Physics running on the main thread");
+    }
 }
 
 void World::OnEvent(const Event& event) {
     if (event.GetType() == EventType::KeyPressed) {
         const auto* keyEvent = dynamic_cast<const KeyPressedEvent*>(&event);
-        if (keyEvent->GetKeyCode() == GLFW_KEY_ESCAPE) {
+        if (keyEvent->GetKeyCode() == Key::Escape) {
             m_IsPaused = !m_IsPaused;
             PauseEvent event(m_IsPaused);
             EventDispatcher::Get().Dispatch(event);
@@ -66,6 +135,10 @@ void World::OnEvent(const Event& event) {
         const auto* pauseEvent = dynamic_cast<const PauseEvent*>(&event);
         m_IsPaused = pauseEvent->isPaused;
     }
+    if (event.GetType() == EventType::TogglePhysicsThread) {
+        const auto* physicsThreadEvent = dynamic_cast<const TogglePhysicsThreadEvent*>(&event);
+        SetPhysicsThreaded(physicsThreadEvent->enable);
+    }
 }
 
 Voxel* World::GetVoxel(const glm::vec3& pos) const {
@@ -3,52 +3,87 @@
 
 #include <FastNoiseLite.h>
 
+#include <atomic>
+#include <chrono>
 #include <glm/gtx/hash.hpp>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "ChunkManager.h"
 #include "CollisionManager.h"
+#include "EntityStore.h"
+#include "PhysicsSystem.h"
 #include "Player.h"
+#include "VoxelGrid.h"
 
 class Renderable;
 class Event;
 class Voxel;
 
-constexpr float GRAVITY = 40.0f;
+constexpr int PHYSICS_MAX_STEPS = 8;  // Physics steps allowed in a single frame, the remaining time is dropped
 
 struct WorldStatus {
     glm::vec3 playerPos;
+    size_t nbLoadedChunks;
+    size_t nbColdChunks;
+    size_t coldChunksBytes;
+    size_t nbLodTiles;
+    std::array<size_t, LOD_NB_LEVELS> ringTriangles;  // Triangles drawn per LOD level, full chunks first
+    size_t farTerrainTriangles;
 
-    WorldStatus() : playerPos(glm::vec3(0)) {}
+    WorldStatus()
+        : playerPos(glm::vec3(0)), nbLoadedChunks(0), nbColdChunks(0), coldChunksBytes(0), nbLodTiles(0), ringTriangles{}, farTerrainTriangles(0) {}
 };
 
-class World {
+class World : public VoxelGrid {
    public:
     World();
-    ~World();
+    ~World() override;
 
-    void Init();
+    void Init(const std::string& savePath = "");  // Chunks are saved to and loaded from savePath when set
     void Update();
 
     void OnEvent(const Event& event);
 
     /* Getters */
+    bool IsPhysicsThreaded() const { return m_PhysicsThreaded; }
     const Player& GetPlayer() const { return m_Player; }
-    Voxel* GetVoxel(const glm::vec3& pos) const;
+    Voxel* GetVoxel(const glm::vec3& pos) const override;
+    EntityStore& GetEntityStore() { return m_EntityStore; }
+    const ChunkManager& GetChunkManager() const { return m_ChunkManager; }
 
     static const WorldStatus& GetStatus() { return m_Status; }
+
+    /* Setters */
+    void SetPhysicsThreaded(bool threaded);
+
     static std::unique_ptr<World> Create();
 
    private:
-    bool m_IsPaused;
+    using Clock = std::chrono::steady_clock;
+
+    std::atomic<bool> m_IsPaused;
+    EntityStore m_EntityStore;  // Declared first, entities unregister from it when destroyed
     Player m_Player;
     ChunkManager m_ChunkManager;
     CollisionManager m_CollisionManager;
+    PhysicsSystem m_PhysicsSystem;
     glm::vec3 m_LastPlayerPos;
 
+    // Fixed timestep
+    double m_Accumulator;  // Frame time not simulated yet
+    Clock::time_point m_LastStepTime;
+    std::atomic<bool> m_PhysicsThreaded;
+    std::thread m_PhysicsThread;
+    std::mutex m_PhysicsMutex;  // Held by whoever simulates or reads the simulation
+
+    void Step();
+    void PhysicsThreadLoop();
+
     static WorldStatus m_Status;
 };
 
@@ -1,22 +1,31 @@
 #include "Application.h"
 
+#include "GLFWInput.h"
 #include "Input.h"
 #include "ThreadPool.h"
 #include "Window.h"
+#include "app/Chunk.h"
 #include "app/Player.h"
 #include "app/World.h"
 #include "events/EventApplication.h"
 #include "events/EventDispatcher.h"
 #include "gfx/Camera.h"
 #include "gfx/Renderer.h"
+#include "gfx/RendererAPI.h"
+#include "gfx/Shader.h"
 #include "pch.h"
 #include "ui/UIManager.h"
 #include "utils/Logger.h"
+#include "utils/Profiler.h"
 #include "utils/Time.h"
 
 AppStatus Application::m_AppStatus;
+FrameStats Application::m_FrameStats;
 
-Application::Application() : m_Renderer(nullptr) {}
+// Milliseconds elapsed since 'start', in seconds from Time::GetCurrentTime
+static float ElapsedMs(double start) { return static_cast<float>((Time::Get().GetCurrentTime() - start) * 1000.0); }
+
+Application::Application(const ApplicationProps& props) : m_Props(props), m_ShouldClose(false), m_FrameCount(0), m_Renderer(nullptr) {}
 
 Application::~Application() {}
 
@@ -25,19 +34,32 @@ void Application::Init() {
     EventDispatcher::Init();
     EventDispatcher::Get().Subscribe(EventCategory::EventCategoryApplication, BIND_EVENT_FN(Application::OnEvent));
 
-    // Init the threadpool
-    ThreadPool::Init(16);
+    // Init the threadpool, sized from the cores unless set
+    ThreadPoolProps threadPoolProps;
+    threadPoolProps.nbThreads = m_Props.nbThreads;
+    threadPoolProps.pinThreads = m_Props.pinThreads;
+    ThreadPool::Init(threadPoolProps);
+
+    if (m_Props.headless) {
+        // Null backend: the shader library only provides layouts and uniforms to the world
+        RendererAPI::SetAPI(RendererAPI::API::None);
+        ShaderProgramLibrary::Init(ASSET_DIRECTORY "shaders/shaders.json");
+        LOG_INFO("Running headless");
+    } else {
+        // Init window
+        m_Window = Window::Create();
+        m_Window->Init();
 
-    // Init window
-    m_Window = Window::Create();
-    m_Window->Init();
+        Input::Init(GLFWInput::Create(m_Window->GetHandler()));  // Init input system
+    }
 
-    Input::Init(m_Window);  // Init input system
-    Time::Init();           // Init timer
+    Time::Init();  // Init timer
 
     // Create the world
     m_World = World::Create();
-    m_World->Init();
+    m_World->Init(m_Props.worldPath);
+
+    if (m_Props.headless) return;
 
     // Init the GUI
     m_UIManager = UIManager::Create();
@@ -50,48 +72,143 @@ void Application::Init() {
     } else {
         // Setup the camera for the renderer
         m_Renderer->SetCamera(m_World->GetPlayer().GetCamera());
+
+        // Haze from the end of the voxel terrain to the edge of the far terrain, rather than a wall at the render distance
+        const float fogStart = static_cast<float>(m_World->GetChunkManager().GetFarDistance() * CHUNK_WIDTH);
+        const float fogEnd = static_cast<float>(m_World->GetChunkManager().GetFarTerrain().GetExtent());
+        m_Renderer->SetFog(fogStart, fogEnd, glm::vec3(0.1f, 0.1f, 0.1f));
     }
 }
 
 void Application::Run() {
+    if (!m_Props.tracePath.empty()) Profiler::Get().StartCapture();
+
+    if (m_Props.headless) {
+        RunHeadless();
+        return;
+    }
+
     /* Loop until the user closes the window */
     m_Window->SetClearColor(0.1f, 0.1f, 0.1f, 1.0f);
     while (!m_Window->ShouldClose()) {
+        Profiler::Get().BeginFrame();
+
         // Clear the content of the window
         m_Window->Clear();
 
         // Updates
         Time::Get().Update();
-        m_World->Update();
-
-        m_Window->Update();
-        m_UIManager->Update();
-
-        m_Renderer->Render();   // My Renderer
-        m_UIManager->Render();  // ImGUI Renderer, last called because overlay
-
-        m_Window->SwapBuffers();  // Swap buffers so after any other render method
+        const double frameStart = Time::Get().GetCurrentTime();
+        FrameTimings timings;
+
+        double stageStart = frameStart;
+        {
+            PROFILE_SCOPE("World::Update");
+            m_World->Update();
+        }
+        {
+            PROFILE_SCOPE("Window::Update");
+            m_Window->Update();
+        }
+        timings.updateMs = ElapsedMs(stageStart);
+
+        stageStart = Time::Get().GetCurrentTime();
+        {
+            PROFILE_SCOPE("UIManager::Update");
+            m_UIManager->Update();
+        }
+        timings.uiMs = ElapsedMs(stageStart);
+
+        stageStart = Time::Get().GetCurrentTime();
+        {
+            PROFILE_SCOPE("Renderer::Render");
+            m_Renderer->Render();  // My Renderer
+        }
+        timings.renderMs = ElapsedMs(stageStart);
+
+        stageStart = Time::Get().GetCurrentTime();
+        {
+            PROFILE_SCOPE("UIManager::Render");
+            m_Renderer->BeginGPUPass(GPUPass::UI);
+            m_UIManager->Render();  // ImGUI Renderer, last called because overlay
+            m_Renderer->EndGPUPass(GPUPass::UI);
+        }
+        timings.uiMs += ElapsedMs(stageStart);
+
+        {
+            PROFILE_SCOPE("Window::SwapBuffers");
+            m_Window->SwapBuffers();  // Swap buffers so after any other render method
+        }
 
         // Update status
         m_AppStatus.FPS = Time::Get().GetFPS();
-        m_AppStatus.drawcalls = m_Window->GetRenderer()->GetDrawcalls();
-        m_AppStatus.nbTrianglesToRender = m_Window->GetRenderer()->GetNbTrianglesRendered();
+        m_AppStatus.drawcalls = m_Renderer->GetDrawcalls();
+        m_AppStatus.nbTrianglesToRender = m_Renderer->GetNbTrianglesRendered();
+        m_AppStatus.gpuTerrainMs = m_Renderer->GetGPUTime(GPUPass::Terrain);
+        m_AppStatus.gpuUIMs = m_Renderer->GetGPUTime(GPUPass::UI);
         m_AppStatus.vsync = m_Window->GetProps()->vsync;
         m_AppStatus.resolution = glm::ivec2(m_Window->GetProps()->width, m_Window->GetProps()->height);
+
+        // GPU results are one frame behind the CPU timings
+        if (m_AppStatus.gpuTerrainMs >= 0.0f && m_AppStatus.gpuUIMs >= 0.0f) timings.gpuMs = m_AppStatus.gpuTerrainMs + m_AppStatus.gpuUIMs;
+        timings.frameMs = ElapsedMs(frameStart);
+        m_FrameStats.Push(timings);
+
+        Profiler::Get().EndFrame();
+
+        if (m_Props.nbFrames != 0 && ++m_FrameCount >= m_Props.nbFrames) break;
     }
 }
 
+void Application::RunHeadless() {
+    const double startTime = Time::Get().GetCurrentTime();
+
+    // Same world update as the windowed loop, without window, UI or renderer
+    while (!m_ShouldClose) {
+        Profiler::Get().BeginFrame();
+
+        Time::Get().Update();
+        const double frameStart = Time::Get().GetCurrentTime();
+        FrameTimings timings;
+        {
+            PROFILE_SCOPE("World::Update");
+            m_World->Update();
+        }
+        timings.updateMs = ElapsedMs(frameStart);
+        timings.frameMs = timings.updateMs;
+        m_FrameStats.Push(timings);
+
+        m_AppStatus.FPS = Time::Get().GetFPS();
+        Profiler::Get().EndFrame();
+
+        if (m_Props.nbFrames != 0 && ++m_FrameCount >= m_Props.nbFrames) break;
+    }
+
+    const double elapsed = Time::Get().GetCurrentTime() - startTime;
+    LOG_INFO("Headless run: {0} frames in {1:.2f} s ({2:.1f} FPS)", m_FrameCount, elapsed, elapsed > 0.0 ? m_FrameCount / elapsed : 0.0);
+
+    // Distribution of the last frames, where streaming hitches show up
+    const FrameTimeSummary summary = m_FrameStats.ComputeSummary();
+    LOG_INFO("Frame time over the last {0} frames: p50 {1:.3f} ms, p95 {2:.3f} ms, p99 {3:.3f} ms, max {4:.3f} ms", summary.nbFrames, summary.p50,
+             summary.p95, summary.p99, summary.max);
+}
+
 void Application::Close() {
-    m_UIManager->Shutdown();
-    m_Window->Shutdown();
+    if (Profiler::Get().IsCapturing()) Profiler::Get().StopCapture(m_Props.tracePath);
+
+    if (m_UIManager) m_UIManager->Shutdown();
+    Input::Shutdown();
+    if (m_Window) m_Window->Shutdown();
+    ThreadPool::Shutdown();  // Runs the queued jobs, before the logger they may write to is gone
     LOG_INFO("Application closed.");
 }
 
 void Application::OnEvent(const Event& event) {
     if (event.GetType() == EventType::WindowClose) {
         const auto* closeEvent = dynamic_cast<const WindowCloseEvent*>(&event);
-        m_Window->Close();
+        if (m_Window) m_Window->Close();
+        m_ShouldClose = true;
     }
 }
 
-Application* Application::Create() { return new Application(); }
+Application* Application::Create(const ApplicationProps& props) { return new Application(props); }
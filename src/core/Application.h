@@ -1,8 +1,12 @@
 #ifndef __APPLICATION_H__
 #define __APPLICATION_H__
 
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <memory>
+#include <string>
+
+#include "utils/FrameStats.h"
 
 class Window;
 class World;
@@ -16,15 +20,29 @@ struct AppStatus {
     float FPS;
     int drawcalls;
     int nbTrianglesToRender;
+    float gpuTerrainMs;  // GPU time of the passes, negative without timer queries
+    float gpuUIMs;
     bool vsync;
     glm::ivec2 resolution;
 
-    AppStatus() : FPS(0), drawcalls(0), nbTrianglesToRender(0), vsync(true), resolution(glm::ivec2(0, 0)) {}
+    AppStatus()
+        : FPS(0), drawcalls(0), nbTrianglesToRender(0), gpuTerrainMs(-1.0f), gpuUIMs(-1.0f), vsync(true), resolution(glm::ivec2(0, 0)) {}
+};
+
+struct ApplicationProps {
+    bool headless;          // No window, no GL context and no UI: simulation only
+    uint64_t nbFrames;      // Stop after this many frames, 0 runs until closed
+    std::string tracePath;  // Capture a profiler trace of the whole run into this file when set
+    std::string worldPath;  // Directory of the region files, empty to regenerate the world every launch
+    size_t nbThreads;       // Workers of the thread pool, 0 for one per core but the main thread's
+    bool pinThreads;        // Bind each worker to its own core
+
+    ApplicationProps() : headless(false), nbFrames(0), worldPath("saves/world"), nbThreads(0), pinThreads(false) {}
 };
 
 class Application {
    public:
-    Application();
+    Application(const ApplicationProps& props);
     ~Application();
 
     void Init();
@@ -36,11 +54,19 @@ class Application {
     /* Getters */
     Window* GetWindow() { return m_Window.get(); }
     World* GetWorld() { return m_World.get(); }
+    const ApplicationProps& GetProps() const { return m_Props; }
     static const AppStatus& GetStatus() { return m_AppStatus; }
+    static const FrameStats& GetFrameStats() { return m_FrameStats; }
 
-    static Application* Create();
+    static Application* Create(const ApplicationProps& props = ApplicationProps());
 
    private:
+    ApplicationProps m_Props;
+    bool m_ShouldClose;
+    uint64_t m_FrameCount;
+
+    void RunHeadless();
+
     std::unique_ptr<Window> m_Window;
     std::unique_ptr<World> m_World;
     std::unique_ptr<UIManager> m_UIManager;
@@ -48,6 +74,7 @@ class Application {
     Renderer* m_Renderer;
 
     static AppStatus m_AppStatus;
+    static FrameStats m_FrameStats;
 };
 
 #endif  // __APPLICATION_H__
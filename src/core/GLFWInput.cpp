@@ -0,0 +1,23 @@
+#include "GLFWInput.h"
+
+#include "gfx/GraphicContext.h"
+#include "pch.h"
+#include "utils/Logger.h"
+
+GLFWInput::GLFWInput(GLFWwindow* handler) : m_Handler(handler) {
+    if (m_Handler == nullptr) {
+        LOG_FATAL("Input: Window handler is null");
+    }
+}
+
+bool GLFWInput::IsKeyPressed(const int keycode) const { return glfwGetKey(m_Handler, keycode) == GLFW_PRESS; }
+
+bool GLFWInput::IsMouseButtonPressed(const int button) const { return glfwGetMouseButton(m_Handler, button) == GLFW_PRESS; }
+
+glm::dvec2 GLFWInput::GetMousePosition() const {
+    glm::dvec2 pos;
+    glfwGetCursorPos(m_Handler, &pos.x, &pos.y);
+    return pos;
+}
+
+std::unique_ptr<GLFWInput> GLFWInput::Create(GLFWwindow* handler) { return std::make_unique<GLFWInput>(handler); }
@@ -0,0 +1,24 @@
+#ifndef __GLFW_INPUT_H__
+#define __GLFW_INPUT_H__
+
+#include <memory>
+
+#include "Input.h"
+
+struct GLFWwindow;
+
+class GLFWInput final : public InputBackend {
+   public:
+    explicit GLFWInput(GLFWwindow* handler);
+
+    bool IsKeyPressed(int keycode) const override;
+    bool IsMouseButtonPressed(int button) const override;
+    glm::dvec2 GetMousePosition() const override;
+
+    static std::unique_ptr<GLFWInput> Create(GLFWwindow* handler);
+
+   private:
+    GLFWwindow* m_Handler;
+};
+
+#endif  // __GLFW_INPUT_H__
@@ -1,25 +1,16 @@
 #include "Input.h"
 
-#include "Window.h"
-#include "gfx/GraphicContext.h"
 #include "pch.h"
-#include "utils/Logger.h"
 
-GLFWwindow* Input::m_Handler = nullptr;
+std::unique_ptr<InputBackend> Input::m_Backend = nullptr;
 
-void Input::Init(const std::unique_ptr<Window>& window) {
-    m_Handler = window->GetHandler();
-    if (m_Handler == nullptr) {
-        LOG_FATAL("Input: Window handler is null");
-    }
-}
+void Input::Init(std::unique_ptr<InputBackend> backend) { m_Backend = std::move(backend); }
 
-bool Input::IsKeyPressed(const int keycode) { return glfwGetKey(m_Handler, keycode) == GLFW_PRESS; }
+void Input::Shutdown() { m_Backend.reset(); }
 
-bool Input::IsMouseButtonPressed(const int button) { return glfwGetMouseButton(m_Handler, button) == GLFW_PRESS; }
+// Without a backend (headless run) nothing is ever pressed and the cursor stays at the origin
+bool Input::IsKeyPressed(const int keycode) { return m_Backend != nullptr && m_Backend->IsKeyPressed(keycode); }
 
-glm::dvec2 Input::GetMousePosition() {
-    glm::dvec2 pos;
-    glfwGetCursorPos(m_Handler, &pos.x, &pos.y);
-    return pos;
-}
+bool Input::IsMouseButtonPressed(const int button) { return m_Backend != nullptr && m_Backend->IsMouseButtonPressed(button); }
+
+glm::dvec2 Input::GetMousePosition() { return m_Backend != nullptr ? m_Backend->GetMousePosition() : glm::dvec2(0.0); }
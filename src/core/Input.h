@@ -1,21 +1,30 @@
 #ifndef __INPUT_H__
 #define __INPUT_H__
 
-struct GLFWwindow;
-class Window;
-
 #include <glm/glm.hpp>
 #include <memory>
 
+// Platform side of the input system, provided by the window layer (see GLFWInput)
+class InputBackend {
+   public:
+    virtual ~InputBackend() = default;
+
+    virtual bool IsKeyPressed(int keycode) const = 0;
+    virtual bool IsMouseButtonPressed(int button) const = 0;
+    virtual glm::dvec2 GetMousePosition() const = 0;
+};
+
 class Input {
    public:
-    static void Init(const std::unique_ptr<Window>& window);
+    static void Init(std::unique_ptr<InputBackend> backend);
+    static void Shutdown();
+
     static bool IsKeyPressed(int keycode);
     static bool IsMouseButtonPressed(int button);
     static glm::dvec2 GetMousePosition();
 
    private:
-    static GLFWwindow* m_Handler;
+    static std::unique_ptr<InputBackend> m_Backend;
 };
 
 #endif  // __INPUT_H__
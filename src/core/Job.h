@@ -0,0 +1,152 @@
+#ifndef __JOB_H__
+#define __JOB_H__
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+constexpr size_t JOB_INLINE_SIZE = 64;  // Bytes of captures stored in the job itself, larger callables go to the heap
+
+// Move-only void() callable with inline storage, the task type of the ThreadPool.
+// Unlike std::function it accepts move-only callables and does not allocate for small captures.
+class Job {
+   public:
+    Job() = default;
+    template <class F, class = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Job>>>
+    Job(F&& f);
+    Job(Job&& other) noexcept { MoveFrom(other); }
+    Job& operator=(Job&& other) noexcept;
+    Job(const Job&) = delete;
+    Job& operator=(const Job&) = delete;
+    ~Job() { Reset(); }
+
+    void operator()() { m_Ops->invoke(m_Storage); }
+    explicit operator bool() const { return m_Ops != nullptr; }
+
+    /* Getters */
+    bool IsInline() const { return m_Ops != nullptr && m_Ops->isInline; }
+
+    template <class F>
+    static constexpr bool FITS_INLINE =
+        sizeof(F) <= JOB_INLINE_SIZE && alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<F>;
+
+   private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*move)(void* destination, void* source);  // Move constructs into destination and destroys source, nullptr to copy the bytes
+        void (*destroy)(void* storage);                 // nullptr when there is nothing to destroy
+        bool isInline;
+    };
+
+    template <class F>
+    struct InlineOps {
+        static constexpr bool TRIVIAL = std::is_trivially_copyable_v<F> && std::is_trivially_destructible_v<F>;
+        static constexpr Ops ops = {
+            [](void* storage) { (*static_cast<F*>(storage))(); },
+            TRIVIAL ? nullptr
+                    : +[](void* destination, void* source) {
+                          new (destination) F(std::move(*static_cast<F*>(source)));
+                          static_cast<F*>(source)->~F();
+                      },
+            TRIVIAL ? nullptr : +[](void* storage) { static_cast<F*>(storage)->~F(); },
+            true,
+        };
+    };
+
+    // The storage only holds a pointer to the callable
+    template <class F>
+    struct HeapOps {
+        static constexpr Ops ops = {
+            [](void* storage) { (**static_cast<F**>(storage))(); },
+            nullptr,
+            [](void* storage) { delete *static_cast<F**>(storage); },
+            false,
+        };
+    };
+
+    void MoveFrom(Job& other) noexcept;
+    void Reset();
+
+    alignas(std::max_align_t) unsigned char m_Storage[JOB_INLINE_SIZE];
+    const Ops* m_Ops = nullptr;
+};
+
+template <class F, class>
+Job::Job(F&& f) {
+    using Callable = std::decay_t<F>;
+    if constexpr (FITS_INLINE<Callable>) {
+        new (m_Storage) Callable(std::forward<F>(f));
+        m_Ops = &InlineOps<Callable>::ops;
+    } else {
+        *reinterpret_cast<Callable**>(m_Storage) = new Callable(std::forward<F>(f));
+        m_Ops = &HeapOps<Callable>::ops;
+    }
+}
+
+inline Job& Job::operator=(Job&& other) noexcept {
+    if (this != &other) {
+        Reset();
+        MoveFrom(other);
+    }
+    return *this;
+}
+
+inline void Job::MoveFrom(Job& other) noexcept {
+    if (other.m_Ops == nullptr) return;
+    if (other.m_Ops->move != nullptr) {
+        other.m_Ops->move(m_Storage, other.m_Storage);
+    } else {
+        std::memcpy(m_Storage, other.m_Storage, JOB_INLINE_SIZE);
+    }
+    m_Ops = other.m_Ops;
+    other.m_Ops = nullptr;
+}
+
+inline void Job::Reset() {
+    if (m_Ops == nullptr) return;
+    if (m_Ops->destroy != nullptr) m_Ops->destroy(m_Storage);
+    m_Ops = nullptr;
+}
+
+// Completion handle for a group of jobs, owned by the caller: ThreadPool::Enqueue(counter, ...) adds one, Wait() blocks until all ran.
+// It must outlive its jobs, which Wait() guarantees.
+class JobCounter {
+   public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    void Wait() {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Condition.wait(lock, [this] { return m_NbPending == 0; });
+    }
+
+    /* Getters */
+    bool IsDone() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_NbPending == 0;
+    }
+
+   private:
+    friend class ThreadPool;
+
+    void Add() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_NbPending++;
+    }
+    // Notified under the lock so a waiter cannot return and destroy the counter before this is done with it
+    void Done() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (--m_NbPending == 0) m_Condition.notify_all();
+    }
+
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    size_t m_NbPending = 0;
+};
+
+#endif  // __JOB_H__
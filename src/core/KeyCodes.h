@@ -0,0 +1,15 @@
+#ifndef __KEY_CODES_H__
+#define __KEY_CODES_H__
+
+// Engine key codes, same values as GLFW so window events and Input queries pass through untouched
+namespace Key {
+constexpr int Space = 32;
+constexpr int A = 65;
+constexpr int D = 68;
+constexpr int S = 83;
+constexpr int W = 87;
+constexpr int Escape = 256;
+constexpr int LeftShift = 340;
+}  // namespace Key
+
+#endif  // __KEY_CODES_H__
@@ -1,27 +1,66 @@
 #include "ThreadPool.h"
 
 #include "pch.h"
+#include "utils/Logger.h"
+#include "utils/Profiler.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
 
 /*static*/ ThreadPool* s_ThreadPoolInst = nullptr;
 
-ThreadPool::ThreadPool(size_t numThreads) {
-    for (size_t i = 0; i < numThreads; ++i) {
-        m_Workers.emplace_back([this] {
-            while (true) {
-                std::function<void()> task;
-                {
-                    std::unique_lock<std::mutex> lock(m_QueueMutex);
-                    m_Condition.wait(lock, [this] { return m_Stop || !m_Tasks.empty(); });
-
-                    if (m_Stop && m_Tasks.empty()) return;  // Exit thread loop if stopping
-
-                    task = std::move(m_Tasks.front());
-                    m_Tasks.pop();
-                }
-                task();  // Execute the task outside the lock
-            }
-        });
-    }
+static const char* s_LaneNames[NB_JOB_LANES] = {"Generation", "Meshing"};
+
+// Name shown by debuggers and system profilers, the Profiler keeps its own
+static void SetNativeThreadName(const std::string& name) {
+#if defined(__linux__)
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());  // 16 bytes with the terminator
+#elif defined(__APPLE__)
+    pthread_setname_np(name.c_str());
+#elif defined(_WIN32)
+    SetThreadDescription(GetCurrentThread(), std::wstring(name.begin(), name.end()).c_str());
+#endif
+}
+
+// Binds the calling thread to one core, returns false where it is not supported
+static bool PinCurrentThread(int core) {
+#if defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core, &cpuSet);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#elif defined(_WIN32)
+    return core < 64 && SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << core) != 0;
+#else
+    return false;
+#endif
+}
+
+ThreadPool::ThreadPool(size_t numThreads) : m_Stop(false) {
+    for (size_t i = 0; i < numThreads; ++i) StartWorker(JobLane::Generation, i, -1);
+}
+
+ThreadPool::ThreadPool(const ThreadPoolProps& props) : m_Stop(false) {
+    const size_t nbCores = GetNbCores();
+    size_t nbThreads = props.nbThreads;
+    if (nbThreads == 0) nbThreads = nbCores > props.nbReservedThreads ? nbCores - props.nbReservedThreads : 1;
+
+    size_t nbMeshingThreads = props.nbMeshingThreads != 0 ? props.nbMeshingThreads : std::max<size_t>(1, nbThreads / 4);
+    nbMeshingThreads = std::min(nbMeshingThreads, nbThreads - 1);
+
+    // Cores after the reserved ones, meshing workers first so they get the same cores on every machine size
+    size_t nbStarted = 0;
+    auto core = [&]() { return props.pinThreads ? static_cast<int>((props.nbReservedThreads + nbStarted++) % nbCores) : -1; };
+    for (size_t i = 0; i < nbMeshingThreads; i++) StartWorker(JobLane::Meshing, i, core());
+    for (size_t i = 0; i < nbThreads - nbMeshingThreads; i++) StartWorker(JobLane::Generation, i, core());
 }
 
 ThreadPool::~ThreadPool() {
@@ -29,7 +68,7 @@ ThreadPool::~ThreadPool() {
         std::unique_lock<std::mutex> lock(m_QueueMutex);
         m_Stop = true;
     }
-    m_Condition.notify_all();  // Wake up all threads to let them exit
+    for (Lane& lane : m_Lanes) lane.condition.notify_all();  // Wake up all threads to let them exit
 
     for (std::thread& worker : m_Workers) {
         if (worker.joinable()) {
@@ -38,7 +77,59 @@ ThreadPool::~ThreadPool() {
     }
 }
 
-void ThreadPool::Init(size_t numThreads) { s_ThreadPoolInst = new ThreadPool(numThreads); }
+void ThreadPool::StartWorker(JobLane lane, size_t index, int core) {
+    Lane& workerLane = m_Lanes[static_cast<size_t>(lane)];
+    workerLane.nbWorkers++;
+    m_Workers.emplace_back([this, &workerLane, name = std::string(s_LaneNames[static_cast<size_t>(lane)]) + " " + std::to_string(index), core] {
+        Profiler::SetThreadName(name);
+        SetNativeThreadName(name);
+        if (core >= 0 && !PinCurrentThread(core)) LOG_WARNING("Could not pin the worker '{0}' to the core {1}", name, core);
+
+        while (true) {
+            Job task;
+            {
+                std::unique_lock<std::mutex> lock(m_QueueMutex);
+                workerLane.condition.wait(lock, [this, &workerLane] { return m_Stop || !m_ParallelTasks.empty() || !workerLane.tasks.empty(); });
+
+                std::queue<Job>& tasks = !m_ParallelTasks.empty() ? m_ParallelTasks : workerLane.tasks;
+                if (m_Stop && tasks.empty()) return;  // Exit thread loop if stopping
+
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            PROFILE_SCOPE("ThreadPool::Job");  // Every job is a top level zone, worker occupancy comes from them
+            task();                            // Execute the task outside the lock
+        }
+    });
+}
+
+JobLane ThreadPool::Route(JobLane lane) const {
+    if (GetNbThreads(lane) != 0) return lane;
+    return lane == JobLane::Generation ? JobLane::Meshing : JobLane::Generation;
+}
+
+void ThreadPool::Push(Job&& job, JobLane lane) {
+    Lane& target = m_Lanes[static_cast<size_t>(Route(lane))];
+    {
+        std::unique_lock<std::mutex> lock(m_QueueMutex);
+        target.tasks.push(std::move(job));
+    }
+    target.condition.notify_one();  // Wake up one worker thread
+}
+
+void ThreadPool::PushParallel(Job&& job) {
+    {
+        std::unique_lock<std::mutex> lock(m_QueueMutex);
+        m_ParallelTasks.push(std::move(job));
+    }
+    for (Lane& lane : m_Lanes) lane.condition.notify_one();  // The first awake worker of either lane takes it
+}
+
+void ThreadPool::Init(const ThreadPoolProps& props) {
+    s_ThreadPoolInst = new ThreadPool(props);
+    LOG_INFO("Thread pool: {0} generation and {1} meshing workers on {2} cores{3}", s_ThreadPoolInst->GetNbThreads(JobLane::Generation),
+             s_ThreadPoolInst->GetNbThreads(JobLane::Meshing), GetNbCores(), props.pinThreads ? ", pinned" : "");
+}
 
 void ThreadPool::Shutdown() {
     delete s_ThreadPoolInst;
@@ -48,4 +139,4 @@ void ThreadPool::Shutdown() {
 ThreadPool& ThreadPool::Get() {
     assert(s_ThreadPoolInst != nullptr);
     return *s_ThreadPoolInst;
-}
\ No newline at end of file
+}
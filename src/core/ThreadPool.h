@@ -1,44 +1,175 @@
 #ifndef __THREADPOOL_H__
 #define __THREADPOOL_H__
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <functional>
+#include <future>
+#include <memory>
 #include <mutex>
 #include <queue>
-#include <vector>
+#include <string>
 #include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "Job.h"
+
+// Workers of a lane only run the jobs of that lane, so long generation jobs never delay the short ones the next frames
+// wait for. The jobs of a lane without workers go to the other lane. ParallelFor ranges skip the lanes, see ParallelFor
+enum class JobLane { Generation, Meshing };  // Meshing also runs the light updates
+constexpr size_t NB_JOB_LANES = 2;
+
+struct ThreadPoolProps {
+    size_t nbThreads;          // Workers of both lanes, 0 for one per core left after the reserved ones
+    size_t nbReservedThreads;  // Cores kept for the main thread, which renders, when sizing from the cores
+    size_t nbMeshingThreads;   // Workers of the meshing lane, 0 for a quarter of them. One generation worker is always kept
+    bool pinThreads;           // Each worker bound to its own core, after the reserved ones
+
+    ThreadPoolProps() : nbThreads(0), nbReservedThreads(1), nbMeshingThreads(0), pinThreads(false) {}
+};
 
 class ThreadPool {
    public:
-    ThreadPool(size_t numThreads);  // Constructor: Initializes the thread pool with the given number of threads
-    ~ThreadPool();                  // Destructor: Shuts down the thread pool and joins all threads
+    ThreadPool(size_t numThreads);  // Constructor: Initializes the thread pool with the given number of generation threads
+    ThreadPool(const ThreadPoolProps& props);
+    ~ThreadPool();  // Destructor: Shuts down the thread pool and joins all threads
 
-    static void Init(size_t numThreads);
+    static void Init(const ThreadPoolProps& props = ThreadPoolProps());
     static void Shutdown();
 
     static ThreadPool& Get();
 
-    // Add a new task to the queue
+    // Add a new task to the queue, f and args are moved into the job (no copy, no allocation for captures up to JOB_INLINE_SIZE)
     template <class F, class... Args>
     void Enqueue(F&& f, Args&&... args);
 
+    // Same, on the given lane
+    template <class F, class... Args>
+    void Enqueue(JobLane lane, F&& f, Args&&... args);
+
+    // Same, counted in counter so the caller can Wait() for the group
+    template <class F, class... Args>
+    void Enqueue(JobCounter& counter, F&& f, Args&&... args);
+
+    // Same, with a future for the result when the caller needs one (allocates the shared state)
+    template <class F, class... Args>
+    auto Submit(F&& f, Args&&... args) -> std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>;
+
+    // Split [0, count) into ranges of grainSize items and call f(begin, end) on each of them.
+    // The calling thread works too and only returns once every range has been processed. Helpers go to a queue the workers
+    // of both lanes take from before their own, so a frame's ParallelFor never waits behind queued chunk jobs.
+    template <class F>
+    void ParallelFor(size_t count, size_t grainSize, F&& f);
+
+    /* Getters */
+    size_t GetNbThreads() const { return m_Workers.size(); }
+    size_t GetNbThreads(JobLane lane) const { return m_Lanes[static_cast<size_t>(lane)].nbWorkers; }
+
+    static size_t GetNbCores() { return std::max(1u, std::thread::hardware_concurrency()); }
+
    private:
-    std::vector<std::thread> m_Workers;         // Worker threads
-    std::queue<std::function<void()>> m_Tasks;  // Task queue
+    struct Lane {
+        std::queue<Job> tasks;
+        std::condition_variable condition;  // Wakes the workers of the lane
+        size_t nbWorkers = 0;
+    };
 
-    std::mutex m_QueueMutex;              // Synchronization
-    std::condition_variable m_Condition;  // Condition variable
-    std::atomic<bool> m_Stop;             // Stop flag
+    void StartWorker(JobLane lane, size_t index, int core);  // core < 0 leaves the worker unpinned
+    JobLane Route(JobLane lane) const;                        // Lane whose workers run the jobs enqueued on lane
+    void Push(Job&& job, JobLane lane = JobLane::Generation);
+    void PushParallel(Job&& job);  // To the workers of every lane, ahead of their queued jobs
+
+    // Callable running f(args...) once, owning moved or copied arguments
+    template <class F, class... Args>
+    static auto Bind(F&& f, Args&&... args);
+
+    std::vector<std::thread> m_Workers;       // Worker threads
+    std::array<Lane, NB_JOB_LANES> m_Lanes;  // Task queues
+    std::queue<Job> m_ParallelTasks;          // ParallelFor helpers
+
+    std::mutex m_QueueMutex;   // Synchronization, for the queues of both lanes
+    std::atomic<bool> m_Stop;  // Stop flag
 };
 
-#endif  // __THREADPOOL_H__
+template <class F, class... Args>
+auto ThreadPool::Bind(F&& f, Args&&... args) {
+    if constexpr (sizeof...(Args) == 0) {
+        return std::decay_t<F>(std::forward<F>(f));
+    } else {
+        return [f = std::forward<F>(f), ... args = std::forward<Args>(args)]() mutable { std::invoke(std::move(f), std::move(args)...); };  // Jobs run once
+    }
+}
 
 template <class F, class... Args>
 void ThreadPool::Enqueue(F&& f, Args&&... args) {
-    {
-        std::unique_lock<std::mutex> lock(m_QueueMutex);
-        m_Tasks.emplace([=] { f(args...); });  // Capture parameters by copy
+    Push(Job(Bind(std::forward<F>(f), std::forward<Args>(args)...)));
+}
+
+template <class F, class... Args>
+void ThreadPool::Enqueue(JobLane lane, F&& f, Args&&... args) {
+    Push(Job(Bind(std::forward<F>(f), std::forward<Args>(args)...)), lane);
+}
+
+template <class F, class... Args>
+void ThreadPool::Enqueue(JobCounter& counter, F&& f, Args&&... args) {
+    counter.Add();
+    Push(Job([counter = &counter, task = Bind(std::forward<F>(f), std::forward<Args>(args)...)]() mutable {
+        task();
+        counter->Done();
+    }));
+}
+
+template <class F, class... Args>
+auto ThreadPool::Submit(F&& f, Args&&... args) -> std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>> {
+    using Result = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+    std::packaged_task<Result()> task(Bind(std::forward<F>(f), std::forward<Args>(args)...));
+    auto future = task.get_future();
+    Push(Job(std::move(task)));
+    return future;
+}
+
+template <class F>
+void ThreadPool::ParallelFor(size_t count, size_t grainSize, F&& f) {
+    if (count == 0) return;
+    grainSize = std::max<size_t>(grainSize, 1);
+    const size_t nbRanges = (count + grainSize - 1) / grainSize;
+    if (nbRanges == 1 || m_Workers.empty()) {
+        f(0, count);
+        return;
+    }
+
+    struct SharedState {
+        std::atomic<size_t> next = 0;  // Next range to claim
+        std::atomic<size_t> done = 0;  // Number of processed ranges
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+    auto job = std::make_shared<SharedState>();
+
+    // Helpers starting after every range has been claimed never touch f, so capturing it by reference is safe
+    auto work = [job, nbRanges, grainSize, count, &f] {
+        size_t range;
+        while ((range = job->next.fetch_add(1, std::memory_order_relaxed)) < nbRanges) {
+            size_t begin = range * grainSize;
+            f(begin, std::min(begin + grainSize, count));
+            if (job->done.fetch_add(1, std::memory_order_acq_rel) + 1 == nbRanges) {
+                std::lock_guard<std::mutex> lock(job->mutex);
+                job->condition.notify_all();
+            }
+        }
+    };
+
+    size_t nbHelpers = std::min(nbRanges - 1, GetNbThreads());
+    for (size_t i = 0; i < nbHelpers; i++) {
+        PushParallel(Job(work));
     }
-    m_Condition.notify_one();  // Wake up one worker thread
-}
\ No newline at end of file
+    work();
+
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->condition.wait(lock, [&job, nbRanges] { return job->done.load(std::memory_order_acquire) == nbRanges; });
+}
+
+#endif  // __THREADPOOL_H__
\ No newline at end of file
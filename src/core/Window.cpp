@@ -138,7 +138,7 @@ void Window::SetVsync(bool enable) {
 std::unique_ptr<Window> Window::Create() { return std::make_unique<Window>(); }
 
 /* Callbacks */
-void Window::_error_callback(int error, const char* description) { LOG_ERROR("GLFW Error (\"{00}\"): {1}", error, description); }
+void Window::_error_callback(int error, const char* description) { LOG_ERROR("GLFW Error (\"{0}\"): {1}", error, description); }
 
 void Window::_framebuffer_size_callback(GLFWwindow* window, const int width, const int height) {
     const auto self = static_cast<Window*>(glfwGetWindowUserPointer(window));
@@ -27,6 +27,7 @@ enum class EventType {
     AddNewRenderable,
     ChunkDataGenerated,
     GodMode,
+    TogglePhysicsThread,
 
     /* Keyboard events */
     KeyPressed,
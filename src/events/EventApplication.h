@@ -182,4 +182,22 @@ class SetGodModeEvent final : public ApplicationEvent {
      }
  };
 
+class TogglePhysicsThreadEvent final : public ApplicationEvent {
+   public:
+    bool enable;
+
+    TogglePhysicsThreadEvent(bool enable) : enable(enable) {}
+
+    EVENT_CLASS_TYPE(EventType::TogglePhysicsThread)
+
+    std::string ToString() const override {
+        std::stringstream ss;
+        if (enable)
+            ss << "Physics thread enable";
+        else
+            ss << "Physics thread disable";
+        return ss.str();
+    }
+};
+
 #endif  // __EVENTAPPLICATION_H__
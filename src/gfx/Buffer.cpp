@@ -24,7 +24,7 @@ void VertexBuffer::Unbind() { glBindBuffer(GL_ARRAY_BUFFER, 0); }
 
 std::shared_ptr<VertexBuffer> VertexBuffer::Create(uint32_t size) { return std::make_shared<VertexBuffer>(size); }
 
-std::shared_ptr<VertexBuffer> VertexBuffer::Create(float* vertices, const uint32_t size) { return std::make_shared<VertexBuffer>(vertices, size); }
+std::shared_ptr<VertexBuffer> VertexBuffer::Create(const float* vertices, const uint32_t size) { return std::make_shared<VertexBuffer>(vertices, size); }
 
 /* Element buffer */
 ElementBuffer::ElementBuffer(const uint32_t* indices, const uint32_t count) {
@@ -40,7 +40,7 @@ void ElementBuffer::Bind() const { glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_Rende
 
 void ElementBuffer::Unbind() { glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); }
 
-std::shared_ptr<ElementBuffer> ElementBuffer::Create(uint32_t* indices, uint32_t count) { return std::make_shared<ElementBuffer>(indices, count); }
+std::shared_ptr<ElementBuffer> ElementBuffer::Create(const uint32_t* indices, uint32_t count) { return std::make_shared<ElementBuffer>(indices, count); }
 
 /* Buffer Layout */
 BufferLayout::BufferLayout(const std::vector<BufferElement>& elements) : m_Elements{elements} {
@@ -134,7 +134,7 @@ class VertexBuffer {
     inline void SetLayout(const std::shared_ptr<BufferLayout>& layout) { m_Layout = layout; }
 
     static std::shared_ptr<VertexBuffer> Create(uint32_t size);
-    static std::shared_ptr<VertexBuffer> Create(float* vertices, uint32_t size);
+    static std::shared_ptr<VertexBuffer> Create(const float* vertices, uint32_t size);
 
    private:
     uint32_t m_RendererID;
@@ -150,7 +150,7 @@ class ElementBuffer {
     void Unbind();
     inline int GetCount() const { return m_Count; };
 
-    static std::shared_ptr<ElementBuffer> Create(uint32_t* indices, uint32_t count);
+    static std::shared_ptr<ElementBuffer> Create(const uint32_t* indices, uint32_t count);
 
    private:
     uint32_t m_RendererID;
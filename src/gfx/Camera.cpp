@@ -6,9 +6,7 @@
 
 #include <glm/gtc/matrix_transform.hpp>
 
-#include "GraphicContext.h"
 #include "core/Input.h"
-#include "core/Window.h"
 #include "events/EventApplication.h"
 #include "events/EventDispatcher.h"
 #include "utils/Logger.h"
@@ -0,0 +1,46 @@
+#include "GPUTimer.h"
+
+#include "pch.h"
+#include "utils/Logger.h"
+
+GPUTimer::GPUTimer() : m_Supported(IsTimerQuerySupported()), m_Queries{}, m_Pending{}, m_Current(0), m_Ms(-1.0f) {
+    if (m_Supported) glGenQueries(GPU_TIMER_NB_QUERIES, m_Queries.data());
+}
+
+GPUTimer::~GPUTimer() {
+    if (m_Supported) glDeleteQueries(GPU_TIMER_NB_QUERIES, m_Queries.data());
+}
+
+bool GPUTimer::IsTimerQuerySupported() {
+    // Core since 3.3, but some drivers expose the query with a zero bit counter
+    if (!GLAD_GL_VERSION_3_3) return false;
+
+    GLint counterBits = 0;
+    glGetQueryiv(GL_TIME_ELAPSED, GL_QUERY_COUNTER_BITS, &counterBits);
+    return counterBits > 0;
+}
+
+void GPUTimer::Begin() {
+    if (!m_Supported) return;
+    glBeginQuery(GL_TIME_ELAPSED, m_Queries[m_Current]);
+}
+
+void GPUTimer::End() {
+    if (!m_Supported) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    m_Pending[m_Current] = true;
+    m_Current = (m_Current + 1) % GPU_TIMER_NB_QUERIES;
+
+    // The next query to reuse is the oldest one, read it only if the GPU already finished it
+    if (!m_Pending[m_Current]) return;
+    GLint available = GL_FALSE;
+    glGetQueryObjectiv(m_Queries[m_Current], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available == GL_FALSE) return;  // Still in flight: drop this sample rather than stall
+
+    GLuint64 elapsed = 0;
+    glGetQueryObjectui64v(m_Queries[m_Current], GL_QUERY_RESULT, &elapsed);
+    m_Ms = static_cast<float>(static_cast<double>(elapsed) / 1e6);
+    m_Pending[m_Current] = false;
+}
+
+std::unique_ptr<GPUTimer> GPUTimer::Create() { return std::make_unique<GPUTimer>(); }
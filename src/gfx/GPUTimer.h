@@ -0,0 +1,39 @@
+#ifndef __GPU_TIMER_H__
+#define __GPU_TIMER_H__
+
+#include <array>
+#include <memory>
+
+#include "GraphicContext.h"
+
+constexpr size_t GPU_TIMER_NB_QUERIES = 2;  // Frame N is read while frame N + 1 is measured
+
+// GL_TIME_ELAPSED query around a pass, double buffered so reading a result never waits for the GPU.
+// Every call is a no-op on contexts without timer queries.
+class GPUTimer {
+   public:
+    GPUTimer();
+    ~GPUTimer();
+
+    GPUTimer(const GPUTimer&) = delete;
+    GPUTimer& operator=(const GPUTimer&) = delete;
+
+    void Begin();
+    void End();  // Also collects the previous frame's result if the GPU is done with it
+
+    /* Getters */
+    bool IsSupported() const { return m_Supported; }
+    float GetMs() const { return m_Ms; }  // Latest result, one frame behind, negative while unavailable
+
+    static bool IsTimerQuerySupported();  // Needs a current context
+    static std::unique_ptr<GPUTimer> Create();
+
+   private:
+    bool m_Supported;
+    std::array<GLuint, GPU_TIMER_NB_QUERIES> m_Queries;
+    std::array<bool, GPU_TIMER_NB_QUERIES> m_Pending;  // Query issued and its result not read yet
+    size_t m_Current;                                  // Query used by the frame being measured
+    float m_Ms;
+};
+
+#endif  // __GPU_TIMER_H__
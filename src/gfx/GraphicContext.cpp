@@ -60,13 +60,13 @@ void APIENTRY glDebugOutputCallBack(GLenum source, GLenum type, GLuint id, GLenu
 
     switch (severity) {
         case GL_DEBUG_SEVERITY_HIGH_ARB:
-            LOG_FATAL(logMsg.str());
+            LOG_FATAL("{0}", logMsg.str());
             break;
         case GL_DEBUG_SEVERITY_MEDIUM_ARB:
-            LOG_ERROR(logMsg.str());
+            LOG_ERROR("{0}", logMsg.str());
             break;
         case GL_DEBUG_SEVERITY_LOW_ARB:
-            LOG_WARNING(logMsg.str());
+            LOG_WARNING("{0}", logMsg.str());
             break;
     }
 }
@@ -1,55 +1,100 @@
 #include "Renderable.h"
 
-#include "Buffer.h"
-#include "Shader.h"
-#include "VertexArray.h"
 #include "pch.h"
 #include "utils/Logger.h"
 
 std::unordered_set<Renderable*> Renderable::m_RenderablesToDraw;
-
-Renderable::~Renderable() { LOG_TRACE("Destroy renderable"); }
+std::atomic<size_t> Renderable::m_ResidentMeshBytes = 0;
+
+Renderable::~Renderable() {
+    LOG_TRACE("Destroy renderable");
+    // Never uploaded
+    if (m_FrontMesh) m_ResidentMeshBytes -= m_FrontMesh->bytes;
+    if (Mesh* pending = m_PendingMesh.load(std::memory_order_acquire)) {
+        m_ResidentMeshBytes -= pending->bytes;
+        delete pending;
+    }
+}
 
 void Renderable::Register() {
-    // Create Vertex Array Object
-    m_VAO = VertexArray::Create();
-
-    // Create Vertex Buffer Object & Element Buffer Object
-    m_VBO = VertexBuffer::Create(m_Vertices.data(), m_Vertices.size() * sizeof(float));
-    m_VBO->SetLayout(m_Shader->GetBufferLayout());
-    m_EBO = ElementBuffer::Create(m_Indices.data(), m_Indices.size());
-
-    m_VAO->AddVertexBuffer(m_VBO);
-    m_VAO->AddElementBuffer(m_EBO);
-
     m_ModelMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(m_Position));
 
+    // A rebuilt mesh replaces the uploaded one on the next draw, see SwapMesh
     m_RenderablesToDraw.insert(this);
 
     m_Registered.store(true, std::memory_order_release);
 }
 
 void Renderable::Unregister() {
+    // Renderables never registered may be destroyed by the worker holding them last, they leave the set alone
+    if (!m_Registered.exchange(false, std::memory_order_acq_rel)) return;
     m_RenderablesToDraw.erase(this);
-    m_Registered.store(false, std::memory_order_release);
 }
 
-bool Renderable::IsRegistered() { return m_Registered; }
+bool Renderable::IsRegistered() const { return m_Registered; }
+
+void Renderable::SetGPUResources(const std::shared_ptr<ShaderProgram>& shader, const std::shared_ptr<VertexArray>& vao,
+                                 const std::shared_ptr<VertexBuffer>& vbo, const std::shared_ptr<ElementBuffer>& ebo) {
+    m_Shader = shader;
+    m_VAO = vao;
+    m_VBO = vbo;
+    m_EBO = ebo;
+}
+
+bool Renderable::SwapMesh() {
+    Mesh* pending = m_PendingMesh.exchange(nullptr, std::memory_order_acquire);
+    if (pending == nullptr) return false;
 
-void Renderable::AddFaceToIndices() {
-    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_FrontMesh) m_ResidentMeshBytes -= m_FrontMesh->bytes;  // Never uploaded, a newer mesh came first
+    m_FrontMesh.reset(pending);
+    return true;
+}
+
+void Renderable::ReleaseCPUMesh() {
+    if (!m_FrontMesh) return;
+    m_ResidentMeshBytes -= m_FrontMesh->bytes;
+    m_FrontMesh.reset();
+}
 
+void Renderable::CommitMesh() {
+    m_BackMesh.bytes = m_BackMesh.vertices.capacity() * sizeof(float) + m_BackMesh.indices.capacity() * sizeof(uint32_t);
+    m_ResidentMeshBytes += m_BackMesh.bytes;
+    m_NbTriangles.store(m_BackMesh.indices.size() / 3, std::memory_order_relaxed);
+
+    // Moved out, the back mesh is left empty for the next build
+    Mesh* stale = m_PendingMesh.exchange(new Mesh(std::move(m_BackMesh)), std::memory_order_acq_rel);
+    m_BackMesh = Mesh();
+    if (stale) {
+        m_ResidentMeshBytes -= stale->bytes;
+        delete stale;
+    }
+}
+
+void Renderable::AddFaceToIndices(bool flipDiagonal) {
+    std::vector<uint32_t>& indices = m_BackMesh.indices;
     int indexStart = 0;
 
-    if (m_Indices.size() != 0) {
-        indexStart = m_Indices.back() + 1;
+    if (indices.size() != 0) {
+        indexStart = indices.back() + 1;
+    }
+
+    // Both splits end on the last vertex, the next face starts after it
+    if (flipDiagonal) {
+        indices.push_back(indexStart);
+        indices.push_back(indexStart + 1);
+        indices.push_back(indexStart + 2);
+
+        indices.push_back(indexStart);
+        indices.push_back(indexStart + 2);
+        indices.push_back(indexStart + 3);
+        return;
     }
 
-    m_Indices.push_back(indexStart);
-    m_Indices.push_back(indexStart + 1);
-    m_Indices.push_back(indexStart + 3);
+    indices.push_back(indexStart);
+    indices.push_back(indexStart + 1);
+    indices.push_back(indexStart + 3);
 
-    m_Indices.push_back(indexStart + 1);
-    m_Indices.push_back(indexStart + 2);
-    m_Indices.push_back(indexStart + 3);
+    indices.push_back(indexStart + 1);
+    indices.push_back(indexStart + 2);
+    indices.push_back(indexStart + 3);
 }
\ No newline at end of file
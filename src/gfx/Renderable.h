@@ -4,7 +4,8 @@
 #include <atomic>
 #include <glm/glm.hpp>
 #include <memory>
-#include <mutex>
+#include <span>
+#include <string>
 #include <unordered_set>
 #include <vector>
 
@@ -13,6 +14,17 @@ class VertexBuffer;
 class ElementBuffer;
 class VertexArray;
 
+// Vertices and indices of one build of a mesh
+struct Mesh {
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+    size_t bytes = 0;  // Counted in the resident mesh bytes from the commit until it is freed
+};
+
+// CPU side of a drawable mesh. GPU buffers are created by the Renderer on the first draw, so
+// nothing here depends on a graphics context. The CPU copy of the mesh is released once uploaded.
+// A mesh is built into the back mesh by one thread at a time, then committed to a pending slot the main thread
+// swaps to the front at the next frame, so a registered renderable can be rebuilt while its last mesh is drawn.
 class Renderable {
    public:
     Renderable(const glm::vec3& position, int ID = 0) : m_Position(position), m_ID(0) { m_RenderablesToDraw.reserve(500); }
@@ -21,7 +33,7 @@ class Renderable {
     virtual void Update() = 0;
     void Register();
     void Unregister();
-    bool IsRegistered();
+    bool IsRegistered() const;
 
     /* Getters */
     int GetID() const { return m_ID; }
@@ -29,15 +41,28 @@ class Renderable {
 
     glm::mat4 GetModelMatrix() const { return m_ModelMatrix; }
 
+    const std::string& GetShaderName() const { return m_ShaderName; }
     std::shared_ptr<ShaderProgram> GetShader() const { return m_Shader; }
-    std::vector<float> GetVertices() const { return m_Vertices; }
-    std::vector<uint32_t> GetIndices() const { return m_Indices; }
+    // Front mesh, empty once uploaded
+    std::span<const float> GetVertices() const { return m_FrontMesh ? m_FrontMesh->vertices : std::span<const float>(); }
+    std::span<const uint32_t> GetIndices() const { return m_FrontMesh ? m_FrontMesh->indices : std::span<const uint32_t>(); }
+    size_t GetNbTriangles() const { return m_NbTriangles.load(std::memory_order_relaxed); }  // Of the last committed mesh, kept once uploaded
 
     std::shared_ptr<VertexBuffer> GetVBO() const { return m_VBO; }
     std::shared_ptr<ElementBuffer> GetEBO() const { return m_EBO; }
     std::shared_ptr<VertexArray> GetVAO() const { return m_VAO; }
 
     static std::unordered_set<Renderable*>& GetRenderablesToDraw() { return m_RenderablesToDraw; }
+    static size_t GetResidentMeshBytes() { return m_ResidentMeshBytes.load(std::memory_order_relaxed); }  // CPU meshes of every renderable
+
+    /* Setters */
+    void SetGPUResources(const std::shared_ptr<ShaderProgram>& shader, const std::shared_ptr<VertexArray>& vao,
+                         const std::shared_ptr<VertexBuffer>& vbo, const std::shared_ptr<ElementBuffer>& ebo);
+
+    // Main thread, at a frame boundary. Takes the last committed mesh as the front mesh, returns whether there was one
+    bool SwapMesh();
+    // Frees the CPU copy of the front mesh, called by the Renderer once the GPU buffers hold it
+    void ReleaseCPUMesh();
 
    protected:
     int m_ID;
@@ -46,20 +71,24 @@ class Renderable {
     glm::vec3 m_Position;
     glm::mat4 m_ModelMatrix = glm::mat4(1.0f);
 
+    std::string m_ShaderName;  // Shader program the renderer binds for this mesh
     std::shared_ptr<ShaderProgram> m_Shader;
 
-    std::mutex m_Mutex;
-    std::vector<float> m_Vertices;
-    std::vector<uint32_t> m_Indices;
+    Mesh m_BackMesh;                             // Being built, by the thread meshing the renderable
+    std::atomic<Mesh*> m_PendingMesh = nullptr;  // Committed and not swapped in yet, replaced by a newer commit
+    std::unique_ptr<Mesh> m_FrontMesh;           // Main thread, until uploaded
+    std::atomic<size_t> m_NbTriangles = 0;
 
     std::shared_ptr<VertexBuffer> m_VBO;
     std::shared_ptr<ElementBuffer> m_EBO;
     std::shared_ptr<VertexArray> m_VAO;
 
-    void AddFaceToIndices();
+    void AddFaceToIndices(bool flipDiagonal = false);  // Quad split along 1-3, or along 0-2 when flipped
+    void CommitMesh();  // Subclasses call it once the back mesh is built, it is handed to the main thread and emptied
 
     // Register all renderables that need to be rendered
     static std::unordered_set<Renderable*> m_RenderablesToDraw;
+    static std::atomic<size_t> m_ResidentMeshBytes;
 };
 
 #endif  // __RENDERABLE_H__
\ No newline at end of file
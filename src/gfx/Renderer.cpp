@@ -12,10 +12,22 @@
 #include "pch.h"
 #include "utils/Logger.h"
 
+constexpr float RENDERER_FAR_PLANE = 12288.0f;  // Past the corners of the far terrain
+
 Renderer::Renderer(int width, int height)
-    : m_Camera(nullptr), m_DrawCalls(0), m_NbTrianglesRendered(0), m_StateGuard(), m_LastShader(nullptr), m_LastVAO(nullptr) {
+    : m_Camera(nullptr),
+      m_StateGuard(),
+      m_DrawCalls(0),
+      m_NbTrianglesRendered(0),
+      m_WireframeMode(false),
+      m_WireframeColor(1.0f),
+      m_FogStart(0.0f),
+      m_FogEnd(0.0f),
+      m_FogColor(0.1f),
+      m_LastShader(nullptr),
+      m_LastVAO(nullptr) {
     float aspectRatio = static_cast<float>(width) / static_cast<float>(height);
-    m_ProjMatrix = glm::perspective(glm::radians(45.0f), aspectRatio, 0.1f, 1000.0f);
+    m_ProjMatrix = glm::perspective(glm::radians(45.0f), aspectRatio, 0.1f, RENDERER_FAR_PLANE);
 }
 
 void Renderer::Init() {
@@ -32,6 +44,9 @@ void Renderer::Init() {
 
     m_StateGuard.Save();
 
+    for (auto& timer : m_GPUTimers) timer = GPUTimer::Create();
+    if (!GPUTimer::IsTimerQuerySupported()) LOG_WARNING("GL timer queries are not supported, GPU timings are disabled");
+
     EventDispatcher::Get().Subscribe(EventCategory::EventCategoryApplication, BIND_EVENT_FN(Renderer::OnEvent));
 }
 
@@ -40,15 +55,16 @@ void Renderer::Render() {
     m_DrawCalls = 0;
     m_NbTrianglesRendered = 0;
 
+    BeginGPUPass(GPUPass::Terrain);
     for (auto& renderable : Renderable::GetRenderablesToDraw()) {
+        if (renderable->SwapMesh() || renderable->GetVAO() == nullptr) Upload(*renderable);  // First draw of this mesh
+
         const auto& ebo = renderable->GetEBO();
         const auto& vao = renderable->GetVAO();
         const auto& shader = renderable->GetShader();
         const auto& modelMatrix = renderable->GetModelMatrix();
         glm::mat4 viewMatrix = (m_Camera) ? m_Camera->GetViewMatrix() : glm::mat4(1.0f);
 
-        m_NbTrianglesRendered += ebo->GetCount() / 3;
-
         // Sanity checks
         if (shader == nullptr) {
             LOG_ERROR("The shader is nullptr for the renderable '{0}'", renderable->GetID());
@@ -59,6 +75,8 @@ void Renderer::Render() {
             continue;
         }
 
+        m_NbTrianglesRendered += ebo->GetCount() / 3;
+
         // Setup the shader
         if (m_LastShader != shader.get()) {  // First pass
             if (m_LastShader) m_LastShader->Unbind();
@@ -71,6 +89,13 @@ void Renderer::Render() {
         shader->GetUniform("viewMatrix")->SetValue(viewMatrix);
         shader->GetUniform("modelMatrix")->SetValue(modelMatrix);  // Update the uniform value
 
+        // Scene uniforms, only for shaders that use them
+        if (shader->HasUniform("wireframeMode")) shader->GetUniform("wireframeMode")->SetValue(m_WireframeMode);
+        if (shader->HasUniform("wireframeColor")) shader->GetUniform("wireframeColor")->SetValue(m_WireframeColor);
+        if (shader->HasUniform("fogStart")) shader->GetUniform("fogStart")->SetValue(m_FogStart);
+        if (shader->HasUniform("fogEnd")) shader->GetUniform("fogEnd")->SetValue(m_FogEnd);
+        if (shader->HasUniform("fogColor")) shader->GetUniform("fogColor")->SetValue(m_FogColor);
+
         // Set the uniforms
         for (auto& [name, uniform] : shader->GetUniforms()) {
             if (uniform->type == ShaderDataType::Bool) {
@@ -99,13 +124,36 @@ void Renderer::Render() {
         // Increase number of drawcalls
         m_DrawCalls++;
     }
+    EndGPUPass(GPUPass::Terrain);
 }
 
 void Renderer::Shutdown() {}
 
+void Renderer::Upload(Renderable& renderable) {
+    auto shader = ShaderProgramLibrary::Get().GetShaderProgram(renderable.GetShaderName());
+    if (shader == nullptr) return;
+
+    // Create Vertex Array Object
+    auto vao = VertexArray::Create();
+
+    // Create Vertex Buffer Object & Element Buffer Object
+    const auto vertices = renderable.GetVertices();
+    const auto indices = renderable.GetIndices();
+    auto vbo = VertexBuffer::Create(vertices.data(), vertices.size() * sizeof(float));
+    vbo->SetLayout(shader->GetBufferLayout());
+    auto ebo = ElementBuffer::Create(indices.data(), indices.size());
+
+    vao->AddVertexBuffer(vbo);
+    vao->AddElementBuffer(ebo);
+
+    renderable.SetGPUResources(shader, vao, vbo, ebo);
+    renderable.ReleaseCPUMesh();
+}
+
 void Renderer::OnEvent(const Event& event) {
     if (event.GetType() == EventType::ToggleWireframeView) {
         const auto* wireframeEvent = dynamic_cast<const ToggleWireframeViewEvent*>(&event);
+        m_WireframeMode = wireframeEvent->enable;
         if (wireframeEvent->enable) {
             glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
         } else {
@@ -116,10 +164,16 @@ void Renderer::OnEvent(const Event& event) {
 
 void Renderer::SetViewport(const int width, const int height) {
     float aspectRatio = static_cast<float>(width) / static_cast<float>(height);
-    m_ProjMatrix = glm::perspective(glm::radians(45.0f), aspectRatio, 0.1f, 1000.0f);
+    m_ProjMatrix = glm::perspective(glm::radians(45.0f), aspectRatio, 0.1f, RENDERER_FAR_PLANE);
     glViewport(0, 0, width, height);
 }
 
 void Renderer::SetCamera(const Camera& camera) { m_Camera = &camera; }
 
+void Renderer::SetFog(const float start, const float end, const glm::vec3& color) {
+    m_FogStart = start;
+    m_FogEnd = end;
+    m_FogColor = color;
+}
+
 std::unique_ptr<Renderer> Renderer::Create(int width, int height) { return std::make_unique<Renderer>(width, height); }
\ No newline at end of file
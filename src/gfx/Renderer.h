@@ -1,10 +1,12 @@
 #ifndef __RENDERER_H__
 #define __RENDERER_H__
 
+#include <array>
 #include <glm/glm.hpp>
 #include <memory>
 #include <unordered_set>
 
+#include "GPUTimer.h"
 #include "GraphicStateGuard.h"
 
 class Renderable;
@@ -13,6 +15,9 @@ class Event;
 class ShaderProgram;
 class VertexArray;
 
+// Passes timed on the GPU
+enum class GPUPass { Terrain = 0, UI, Count };
+
 class Renderer {
    public:
     Renderer(int width, int height);
@@ -24,22 +29,38 @@ class Renderer {
 
     void OnEvent(const Event& event);
 
+    // Timer query around a pass, the terrain pass is timed by Render itself
+    void BeginGPUPass(GPUPass pass) { m_GPUTimers[static_cast<size_t>(pass)]->Begin(); }
+    void EndGPUPass(GPUPass pass) { m_GPUTimers[static_cast<size_t>(pass)]->End(); }
+
     /* Getters */
     int GetDrawcalls() const { return m_DrawCalls; }
     int GetNbTrianglesRendered() const { return m_NbTrianglesRendered; }
+    float GetGPUTime(GPUPass pass) const { return m_GPUTimers[static_cast<size_t>(pass)]->GetMs(); }  // Negative when unavailable
 
     /* Setters */
     void SetViewport(const int width, const int height);
     void SetCamera(const Camera& camera);
+    void SetFog(float start, float end, const glm::vec3& color);
 
     static std::unique_ptr<Renderer> Create(int width, int height);
 
    private:
+    void Upload(Renderable& renderable);
+
     const Camera* m_Camera;
     GraphicStateGuard m_StateGuard;
     glm::mat4 m_ProjMatrix;
     int m_DrawCalls;
     int m_NbTrianglesRendered;
+    std::array<std::unique_ptr<GPUTimer>, static_cast<size_t>(GPUPass::Count)> m_GPUTimers;
+
+    // Scene uniforms, shared by every shader declaring them
+    bool m_WireframeMode;
+    glm::vec3 m_WireframeColor;
+    float m_FogStart;
+    float m_FogEnd;
+    glm::vec3 m_FogColor;
 
     ShaderProgram* m_LastShader;
     VertexArray* m_LastVAO;
@@ -0,0 +1,3 @@
+#include "RendererAPI.h"
+
+RendererAPI::API RendererAPI::m_API = RendererAPI::API::OpenGL;
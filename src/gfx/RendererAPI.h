@@ -0,0 +1,21 @@
+#ifndef __RENDERER_API_H__
+#define __RENDERER_API_H__
+
+// Graphics backend selected at startup. With 'None' no GL call is ever made: shaders only
+// keep their layout and uniforms, and renderables keep their mesh on the CPU.
+class RendererAPI {
+   public:
+    enum class API { None = 0, OpenGL };
+
+    /* Getters */
+    static API GetAPI() { return m_API; }
+    static bool IsHeadless() { return m_API == API::None; }
+
+    /* Setters */
+    static void SetAPI(API api) { m_API = api; }
+
+   private:
+    static API m_API;
+};
+
+#endif  // __RENDERER_API_H__
@@ -4,6 +4,7 @@
 
 #include "Buffer.h"
 #include "GraphicContext.h"
+#include "RendererAPI.h"
 #include "pch.h"
 #include "utils/File.h"
 #include "utils/Logger.h"
@@ -12,7 +13,15 @@ using json = nlohmann::json;
 
 /* Shader */
 ShaderProgram::ShaderProgram(const std::string& name, const std::vector<Shader>& shaders, const std::vector<BufferElement>& bufferElements)
-    : m_Name(name) {
+    : m_RendererID(0), m_Name(name) {
+    m_BufferLayout = std::make_shared<BufferLayout>(bufferElements);
+
+    // Headless: keep the layout and the uniforms, there is nothing to compile against
+    if (RendererAPI::IsHeadless()) {
+        LOG_INFO("Shader '{0}' loaded without a graphics backend", name);
+        return;
+    }
+
     m_RendererID = glCreateProgram();
 
     const auto shaderIDs = new uint32_t[shaders.size()];
@@ -28,19 +37,24 @@ ShaderProgram::ShaderProgram(const std::string& name, const std::vector<Shader>&
         glDeleteShader(shaderIDs[i]);
     }
 
-    m_BufferLayout = std::make_shared<BufferLayout>(bufferElements);
-
     delete[] shaderIDs;
     LOG_INFO("Shader '{0}' build succesful", name);
 }
 
-ShaderProgram::~ShaderProgram() { glDeleteProgram(m_RendererID); }
+ShaderProgram::~ShaderProgram() {
+    if (m_RendererID != 0) glDeleteProgram(m_RendererID);
+}
 
-void ShaderProgram::Bind() const { glUseProgram(m_RendererID); }
+void ShaderProgram::Bind() const {
+    if (m_RendererID != 0) glUseProgram(m_RendererID);
+}
 
-void ShaderProgram::Unbind() const { glUseProgram(0); }
+void ShaderProgram::Unbind() const {
+    if (m_RendererID != 0) glUseProgram(0);
+}
 
 void ShaderProgram::SetUniformBool(const std::string& name, bool value) const {
+    if (m_RendererID == 0) return;
     const GLint uniformLoc = glGetUniformLocation(m_RendererID, name.c_str());
     if (uniformLoc == -1) {
         LOG_WARNING("Warning: Unable to find the uniform \'{0}\'", name);
@@ -49,6 +63,7 @@ void ShaderProgram::SetUniformBool(const std::string& name, bool value) const {
 }
 
 void ShaderProgram::SetUniformInt(const std::string& name, const int value) const {
+    if (m_RendererID == 0) return;
     const GLint uniformLoc = glGetUniformLocation(m_RendererID, name.c_str());
     if (uniformLoc == -1) {
         LOG_WARNING("Warning: Unable to find the uniform \'{0}\'", name);
@@ -59,6 +74,7 @@ void ShaderProgram::SetUniformInt(const std::string& name, const int value) cons
 void ShaderProgram::SetUniformIntArray(const std::string& name, int* values, uint32_t count) const {}
 
 void ShaderProgram::SetUniformFloat(const std::string& name, const float value) const {
+    if (m_RendererID == 0) return;
     const GLint uniformLoc = glGetUniformLocation(m_RendererID, name.c_str());
     if (uniformLoc == -1) {
         LOG_WARNING("Warning: Unable to find the uniform \'{0}\'", name);
@@ -69,6 +85,7 @@ void ShaderProgram::SetUniformFloat(const std::string& name, const float value)
 void ShaderProgram::SetUniformFloat2(const std::string& name, const glm::vec2& value) const {}
 
 void ShaderProgram::SetUniformFloat3(const std::string& name, const glm::vec3& value) const {
+    if (m_RendererID == 0) return;
     const GLint uniformLoc = glGetUniformLocation(m_RendererID, name.c_str());
 
     if (uniformLoc == -1) {
@@ -80,6 +97,7 @@ void ShaderProgram::SetUniformFloat3(const std::string& name, const glm::vec3& v
 void ShaderProgram::SetUniformFloat4(const std::string& name, const glm::vec4& value) const {}
 
 void ShaderProgram::SetUniformMat4(const std::string& name, const glm::mat4& value) const {
+    if (m_RendererID == 0) return;
     const GLint uniformLoc = glGetUniformLocation(m_RendererID, name.c_str());
     if (uniformLoc == -1) {
         LOG_WARNING("Warning: Unable to find the uniform \'{0}\'", name);
@@ -62,6 +62,7 @@ class ShaderProgram {
     inline const std::string& GetName() const { return m_Name; }
     inline std::shared_ptr<BufferLayout> GetBufferLayout() const { return m_BufferLayout; }
     Uniform* GetUniform(const std::string& name) { return m_Uniforms[name].get(); }
+    bool HasUniform(const std::string& name) const { return m_Uniforms.contains(name); }
     const std::unordered_map<std::string, std::unique_ptr<Uniform>>& GetUniforms() const { return m_Uniforms; }
 
     static GLenum ShaderTypeFromString(const std::string& typeStr);
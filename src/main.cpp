@@ -1,10 +1,51 @@
+#include <charconv>
+#include <cstring>
+#include <string>
+
 #include "core/Application.h"
 #include "utils/Logger.h"
+#include "utils/Profiler.h"
+
+// Whole value of a numeric argument, a malformed one is logged and leaves value unchanged
+template <class T>
+static void ParseNumber(const char* arg, const char* value, T& out) {
+    const char* end = value + std::strlen(value);
+    T parsed;
+    const auto [ptr, error] = std::from_chars(value, end, parsed);
+    if (error != std::errc() || ptr != end) {
+        LOG_WARNING("Ignoring the malformed argument '{0}'", arg);
+        return;
+    }
+    out = parsed;
+}
+
+// Usage: Voxelinity [--headless] [--frames=N] [--trace=<file>] [--world=<directory>, empty to disable saving]
+//                   [--threads=N, 0 for one per core] [--pin-threads]
+static ApplicationProps ParseArgs(int argc, char** argv) {
+    ApplicationProps props;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            props.headless = true;
+        } else if (std::strncmp(argv[i], "--frames=", 9) == 0) {
+            ParseNumber(argv[i], argv[i] + 9, props.nbFrames);
+        } else if (std::strncmp(argv[i], "--trace=", 8) == 0) {
+            props.tracePath = argv[i] + 8;
+        } else if (std::strncmp(argv[i], "--world=", 8) == 0) {
+            props.worldPath = argv[i] + 8;
+        } else if (std::strncmp(argv[i], "--threads=", 10) == 0) {
+            ParseNumber(argv[i], argv[i] + 10, props.nbThreads);
+        } else if (std::strcmp(argv[i], "--pin-threads") == 0) {
+            props.pinThreads = true;
+        }
+    }
+    return props;
+}
 
-int main(void) {
-    auto app = Application::Create();
+int main(int argc, char** argv) {
+    Logger::Init();    // Initialize the logger, before the arguments it reports
+    Profiler::Init();  // Before any thread records a zone
 
-    Logger::Init();  // Initialize the logger
+    auto app = Application::Create(ParseArgs(argc, argv));
 
     app->Init();
     app->Run();
@@ -12,6 +53,7 @@ int main(void) {
 
     delete app;
 
+    Profiler::Shutdown();
     Logger::Shutdown();  // Destroy thhe logger
 
     return 0;
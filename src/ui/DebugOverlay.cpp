@@ -5,13 +5,19 @@
 #include "core/Input.h"
 #include "core/Window.h"
 #include "gfx/GraphicContext.h"
+#include "gfx/Renderable.h"
 #include "gfx/Renderer.h"
 #include "pch.h"
 #include "utils/Logger.h"
+#include "utils/Profiler.h"
 #include "utils/Time.h"
 
 // FPS print refresh rate in second;
 constexpr double FPSRefreshRate = 0.2;
+constexpr float FRAME_PLOT_HEIGHT = 60.0f;
+constexpr float FRAME_PLOT_MIN_SCALE_MS = 33.3f;  // The plot never zooms in past 30 FPS, so small jitter does not look like a spike
+constexpr size_t PROFILER_MAX_ZONES_SHOWN = 12;
+constexpr const char* PROFILER_TRACE_FILE = "voxelinity_trace.json";
 
 DebugOverlay::DebugOverlay(bool open) : UIWindow("DebugOverlay", open) {}
 
@@ -52,6 +58,10 @@ void DebugOverlay::Show() {
         if (m_FPSRefreshTime >= FPSRefreshRate) {
             m_DeltaTime = Time::Get().GetDeltaTime();
             m_FPS = Time::Get().GetFPS();
+            m_FrameTimes = Application::GetFrameStats().ComputeSummary();
+            m_ProfilerFrameMs = Profiler::Get().GetFrameMs();
+            m_Zones = Profiler::Get().GetFrameZones();
+            m_Threads = Profiler::Get().GetThreadStats();
             m_FPSRefreshTime = 0.0;
         }
         static int samples;
@@ -59,16 +69,33 @@ void DebugOverlay::Show() {
         ImGui::Text("OpenGL Version: %s", glGetString(GL_VERSION));
         ImGui::Text("Renderer: %s", glGetString(GL_RENDERER));
         ImGui::Text("Resolution: %dx%d", Application::GetStatus().resolution.x, Application::GetStatus().resolution.y);
-        ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", m_DeltaTime, m_FPS);
+        ImGui::Text("Application %.3f ms/frame (%.1f FPS)", m_DeltaTime * 1000.0, m_FPS);
         ImGui::Text("VSync: %s", Application::GetStatus().vsync ? "Enable" : "Disable");
         ImGui::Text("MSAA: %dx", samples);
         ImGui::Text("Draw calls: %d", Application::GetStatus().drawcalls);
         ImGui::Text("Triangles: %d", Application::GetStatus().nbTrianglesToRender);
+        ImGui::Text("CPU meshes: %.2f MiB resident", Renderable::GetResidentMeshBytes() / (1024.0 * 1024.0));
+        if (Application::GetStatus().gpuTerrainMs >= 0.0f) {
+            ImGui::Text("GPU terrain: %.3f ms, UI: %.3f ms", Application::GetStatus().gpuTerrainMs, Application::GetStatus().gpuUIMs);
+        } else {
+            ImGui::Text("GPU timings: not supported by this context");
+        }
         ImGui::Separator();
 
         // World info
         auto pos = World::GetStatus().playerPos;
         ImGui::Text("XYZ: %.3f / %.3f / %.3f", pos.x, pos.y, pos.z);
+        ImGui::Text("Chunks: %zu loaded, %zu cold (%.2f MiB)", World::GetStatus().nbLoadedChunks, World::GetStatus().nbColdChunks,
+                    World::GetStatus().coldChunksBytes / (1024.0 * 1024.0));
+        const auto& rings = World::GetStatus().ringTriangles;
+        ImGui::Text("LOD: %zu tiles, triangles per ring %zu / %zu / %zu / %zu", World::GetStatus().nbLodTiles, rings[0], rings[1], rings[2], rings[3]);
+        ImGui::Text("Far terrain: %zu triangles", World::GetStatus().farTerrainTriangles);
+        ImGui::Separator();
+
+        ShowFrameTimes();
+        ImGui::Separator();
+
+        ShowProfiler();
 
         if (ImGui::BeginPopupContextWindow()) {
             if (ImGui::MenuItem("Custom", NULL, location == -1)) location = -1;
@@ -83,3 +110,50 @@ void DebugOverlay::Show() {
     }
     ImGui::End();
 }
+
+void DebugOverlay::ShowFrameTimes() {
+    const FrameStats& stats = Application::GetFrameStats();
+
+    ImGui::Text("Frame time (last %zu frames)", m_FrameTimes.nbFrames);
+    ImGui::Text("  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms", m_FrameTimes.p50, m_FrameTimes.p95, m_FrameTimes.p99, m_FrameTimes.max);
+    ImGui::Text("  CPU update %.2f  render %.2f  UI %.2f ms", m_FrameTimes.avgUpdateMs, m_FrameTimes.avgRenderMs, m_FrameTimes.avgUIMs);
+    if (m_FrameTimes.avgGPUMs >= 0.0f) {
+        ImGui::Text("  GPU %.2f ms", m_FrameTimes.avgGPUMs);
+    } else {
+        ImGui::Text("  GPU n/a");
+    }
+
+    // One bar per frame, oldest on the left; the scale follows the worst frame so hitches stand out
+    char overlay[32];
+    std::snprintf(overlay, sizeof(overlay), "max %.2f ms", m_FrameTimes.max);
+    ImGui::PlotHistogram("##FrameTimes", stats.GetFrameTimes(), static_cast<int>(stats.GetSize()), static_cast<int>(stats.GetOffset()), overlay, 0.0f,
+                         std::max(m_FrameTimes.max, FRAME_PLOT_MIN_SCALE_MS), ImVec2(static_cast<float>(FRAME_HISTORY_SIZE) / 2.0f, FRAME_PLOT_HEIGHT));
+}
+
+void DebugOverlay::ShowProfiler() {
+#ifndef VOXELINITY_PROFILE
+    ImGui::Text("Profiler: compiled out (VOXELINITY_PROFILING=OFF)");
+#else
+    ImGui::Text("CPU frame: %.3f ms", m_ProfilerFrameMs);
+
+    // Main thread zones, inclusive time
+    for (size_t i = 0; i < m_Zones.size() && i < PROFILER_MAX_ZONES_SHOWN; i++) {
+        ImGui::Text("  %-32s %7.3f ms  x%u", m_Zones[i].name.c_str(), m_Zones[i].totalMs, m_Zones[i].calls);
+    }
+
+    // Time each thread spent in jobs during the frame
+    for (const auto& thread : m_Threads) {
+        char label[32];
+        std::snprintf(label, sizeof(label), "%.0f%%", thread.occupancy * 100.0);
+        ImGui::ProgressBar(static_cast<float>(std::min(thread.occupancy, 1.0)), ImVec2(120.0f, 0.0f), label);
+        ImGui::SameLine();
+        ImGui::Text("%s", thread.name.c_str());
+    }
+
+    if (!Profiler::Get().IsCapturing()) {
+        if (ImGui::Button("Start trace capture")) Profiler::Get().StartCapture();
+    } else {
+        if (ImGui::Button("Save trace")) Profiler::Get().StopCapture(PROFILER_TRACE_FILE);
+    }
+#endif
+}
@@ -2,8 +2,11 @@
 #define __DEBUG_OVERLAY_H__
 
 #include <memory>
+#include <vector>
 
 #include "UIWindow.h"
+#include "utils/FrameStats.h"
+#include "utils/Profiler.h"
 
 class Application;
 
@@ -20,6 +23,15 @@ class DebugOverlay : public UIWindow {
    private:
     double m_FPSRefreshTime = 0.0;
     double m_DeltaTime = 0.0, m_FPS = 0.0;
+    FrameTimeSummary m_FrameTimes;  // Percentiles over the frame history, refreshed with the FPS
+
+    // Profiler snapshot, refreshed with the FPS
+    double m_ProfilerFrameMs = 0.0;
+    std::vector<ZoneStats> m_Zones;
+    std::vector<ThreadStats> m_Threads;
+
+    void ShowFrameTimes();
+    void ShowProfiler();
 };
 
 #endif  // __DEBUG_OVERLAY_H__
\ No newline at end of file
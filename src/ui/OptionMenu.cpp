@@ -60,6 +60,16 @@ void OptionMenu::Show() {
             EventDispatcher::Get().Dispatch(event);
         }
 
+        static bool physicsThreadEnable = false;
+        ImGui::Checkbox("Physics on its own thread", &physicsThreadEnable);
+        if (physicsThreadEnable) {
+            TogglePhysicsThreadEvent event(true);
+            EventDispatcher::Get().Dispatch(event);
+        } else {
+            TogglePhysicsThreadEvent event(false);
+            EventDispatcher::Get().Dispatch(event);
+        }
+
         if (ImGui::Button("Back")) {
             Close();
             if (m_ParentMenu != nullptr) m_ParentMenu->Open();
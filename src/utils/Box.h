@@ -15,6 +15,12 @@ struct Box {
         max += delta;
     }
 
+    // Grow the box so it covers its whole path along delta
+    void Expand(const glm::vec3& delta) {
+        min = glm::min(min, min + delta);
+        max = glm::max(max, max + delta);
+    }
+
     // Checks if this box collides with another box
     bool Intersects(const Box& other) const {
         return (min.x <= other.max.x && max.x >= other.min.x) && (min.y <= other.max.y && max.y >= other.min.y) &&
@@ -0,0 +1,64 @@
+#include "FrameStats.h"
+
+#include <cmath>
+
+#include "pch.h"
+
+FrameStats::FrameStats() : m_Next(0), m_Size(0) { Clear(); }
+
+void FrameStats::Push(const FrameTimings& timings) {
+    m_FrameMs[m_Next] = timings.frameMs;
+    m_UpdateMs[m_Next] = timings.updateMs;
+    m_RenderMs[m_Next] = timings.renderMs;
+    m_UIMs[m_Next] = timings.uiMs;
+    m_GPUMs[m_Next] = timings.gpuMs;
+
+    m_Next = (m_Next + 1) % FRAME_HISTORY_SIZE;
+    m_Size = std::min(m_Size + 1, FRAME_HISTORY_SIZE);
+}
+
+void FrameStats::Clear() {
+    m_FrameMs.fill(0.0f);
+    m_UpdateMs.fill(0.0f);
+    m_RenderMs.fill(0.0f);
+    m_UIMs.fill(0.0f);
+    m_GPUMs.fill(-1.0f);
+    m_Next = 0;
+    m_Size = 0;
+}
+
+FrameTimeSummary FrameStats::ComputeSummary() const {
+    FrameTimeSummary summary;
+    summary.nbFrames = m_Size;
+    if (m_Size == 0) return summary;
+
+    // Slots [0, m_Size) are all valid, whether the ring has wrapped or not
+    std::array<float, FRAME_HISTORY_SIZE> sorted;
+    std::copy(m_FrameMs.begin(), m_FrameMs.begin() + m_Size, sorted.begin());
+    std::sort(sorted.begin(), sorted.begin() + m_Size);
+
+    // Nearest rank percentile
+    auto percentile = [&](double p) { return sorted[std::min(m_Size - 1, static_cast<size_t>(std::ceil(p * m_Size)) - 1)]; };
+    summary.p50 = percentile(0.50);
+    summary.p95 = percentile(0.95);
+    summary.p99 = percentile(0.99);
+    summary.max = sorted[m_Size - 1];
+
+    double update = 0.0, render = 0.0, ui = 0.0, gpu = 0.0;
+    size_t nbGPUFrames = 0;
+    for (size_t i = 0; i < m_Size; i++) {
+        update += m_UpdateMs[i];
+        render += m_RenderMs[i];
+        ui += m_UIMs[i];
+        if (m_GPUMs[i] >= 0.0f) {
+            gpu += m_GPUMs[i];
+            nbGPUFrames++;
+        }
+    }
+    summary.avgUpdateMs = static_cast<float>(update / m_Size);
+    summary.avgRenderMs = static_cast<float>(render / m_Size);
+    summary.avgUIMs = static_cast<float>(ui / m_Size);
+    if (nbGPUFrames > 0) summary.avgGPUMs = static_cast<float>(gpu / nbGPUFrames);
+
+    return summary;
+}
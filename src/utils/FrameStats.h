@@ -0,0 +1,62 @@
+#ifndef __FRAME_STATS_H__
+#define __FRAME_STATS_H__
+
+#include <array>
+#include <cstddef>
+
+constexpr size_t FRAME_HISTORY_SIZE = 512;  // Frames kept in the rolling history, about 8 s at 60 FPS
+
+// Timings of one frame in milliseconds
+struct FrameTimings {
+    float frameMs;   // Whole frame, swap included
+    float updateMs;  // CPU: world update and input polling
+    float renderMs;  // CPU: renderer submission
+    float uiMs;      // CPU: ImGui update and submission
+    float gpuMs;     // GPU: measured by timer queries, negative when unavailable
+
+    FrameTimings() : frameMs(0.0f), updateMs(0.0f), renderMs(0.0f), uiMs(0.0f), gpuMs(-1.0f) {}
+};
+
+// Frame time distribution over the history
+struct FrameTimeSummary {
+    size_t nbFrames;
+    float p50, p95, p99, max;
+    float avgUpdateMs, avgRenderMs, avgUIMs;
+    float avgGPUMs;  // Negative when no frame of the history had a GPU time
+
+    FrameTimeSummary() : nbFrames(0), p50(0.0f), p95(0.0f), p99(0.0f), max(0.0f), avgUpdateMs(0.0f), avgRenderMs(0.0f), avgUIMs(0.0f), avgGPUMs(-1.0f) {}
+};
+
+// Rolling history of the last FRAME_HISTORY_SIZE frames, one series per timing so each can be plotted directly
+class FrameStats {
+   public:
+    FrameStats();
+
+    void Push(const FrameTimings& timings);
+    void Clear();
+
+    // Sorts a copy of the history, meant to be called a few times per second rather than every frame
+    FrameTimeSummary ComputeSummary() const;
+
+    /* Getters */
+    size_t GetSize() const { return m_Size; }
+    // Index of the oldest frame in the series, to pass as the ImGui plot offset
+    size_t GetOffset() const { return m_Size < FRAME_HISTORY_SIZE ? 0 : m_Next; }
+    const float* GetFrameTimes() const { return m_FrameMs.data(); }
+    const float* GetUpdateTimes() const { return m_UpdateMs.data(); }
+    const float* GetRenderTimes() const { return m_RenderMs.data(); }
+    const float* GetUITimes() const { return m_UIMs.data(); }
+    const float* GetGPUTimes() const { return m_GPUMs.data(); }
+
+   private:
+    std::array<float, FRAME_HISTORY_SIZE> m_FrameMs;
+    std::array<float, FRAME_HISTORY_SIZE> m_UpdateMs;
+    std::array<float, FRAME_HISTORY_SIZE> m_RenderMs;
+    std::array<float, FRAME_HISTORY_SIZE> m_UIMs;
+    std::array<float, FRAME_HISTORY_SIZE> m_GPUMs;
+
+    size_t m_Next;  // Slot the next frame is written to
+    size_t m_Size;
+};
+
+#endif  // __FRAME_STATS_H__
@@ -4,6 +4,43 @@
 
 /*static*/ Logger* s_LoggerInst = nullptr;
 
+// Ring of the calling thread, re-registered if the logger was restarted
+thread_local Logger* t_LoggerOwner = nullptr;
+thread_local void* t_LoggerBuffer = nullptr;
+
+#define ANSI_RESET "\033[0m"
+#define ANSI_RED "\033[31m"
+#define ANSI_GREEN "\033[32m"
+#define ANSI_YELLOW "\033[33m"
+#define ANSI_BLUE "\033[34m"
+
+static const char* LevelPrefix(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace:
+            return ANSI_BLUE "[TRACE] ";
+        case LogLevel::Info:
+            return ANSI_GREEN "[INFO] ";
+        case LogLevel::Warning:
+            return ANSI_YELLOW "[WARNING] ";
+        case LogLevel::Error:
+            return ANSI_RED "[ERROR] ";
+        case LogLevel::Fatal:
+            return ANSI_RED "[FATAL] ";
+    }
+    return "";
+}
+
+Logger::Logger() : m_Dropped(0), m_LimitedSites(nullptr), m_FlushRequests(0), m_FlushesDone(0), m_Stop(false) { m_Writer = std::thread(&Logger::WriterLoop, this); }
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(m_WriterMutex);
+        m_Stop = true;
+    }
+    m_WakeWriter.notify_one();
+    m_Writer.join();  // The writer drains everything left before exiting
+}
+
 void Logger::Init() { s_LoggerInst = new Logger(); }
 
 void Logger::Shutdown() {
@@ -15,3 +52,129 @@ Logger& Logger::Get() {
     assert(s_LoggerInst != nullptr);
     return *s_LoggerInst;
 }
+
+uint64_t Logger::Now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+bool Logger::AcquireSite(LogSite& site, LogLevel level, std::string_view format, uint32_t& suppressed) {
+    const uint64_t now = Now();
+    uint64_t windowStart = site.windowStart.load(std::memory_order_relaxed);
+
+    // First message of a new window: report what the previous one dropped
+    if (now - windowStart >= LOG_RATE_WINDOW_NS && site.windowStart.compare_exchange_strong(windowStart, now, std::memory_order_relaxed)) {
+        site.count.store(1, std::memory_order_relaxed);
+        suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    if (site.count.fetch_add(1, std::memory_order_relaxed) < LOG_RATE_LIMIT) return true;
+    site.suppressed.fetch_add(1, std::memory_order_relaxed);
+
+    if (!site.listed.exchange(true, std::memory_order_relaxed)) {
+        site.level = level;
+        site.format = format;
+        site.next = m_LimitedSites.load(std::memory_order_relaxed);
+        while (!m_LimitedSites.compare_exchange_weak(site.next, &site, std::memory_order_release, std::memory_order_relaxed)) {}
+    }
+    return false;
+}
+
+Logger::ThreadBuffer* Logger::GetThreadBuffer() {
+    if (t_LoggerOwner == this) return static_cast<ThreadBuffer*>(t_LoggerBuffer);
+
+    // First message of this thread, registration is the only locked step
+    std::lock_guard<std::mutex> lock(m_BuffersMutex);
+    m_Buffers.push_back(std::make_unique<ThreadBuffer>());
+    t_LoggerOwner = this;
+    t_LoggerBuffer = m_Buffers.back().get();
+    return m_Buffers.back().get();
+}
+
+LogRecord* Logger::BeginRecord(ThreadBuffer*& buffer) {
+    buffer = GetThreadBuffer();
+    const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    if (head - buffer->tail.load(std::memory_order_acquire) >= LOG_BUFFER_SIZE) {
+        m_Dropped.fetch_add(1, std::memory_order_relaxed);  // The writer is behind, never wait for it
+        return nullptr;
+    }
+    return &buffer->records[head & (LOG_BUFFER_SIZE - 1)];
+}
+
+void Logger::Flush() {
+    std::unique_lock<std::mutex> lock(m_WriterMutex);
+    if (m_Stop) return;  // Shutting down, the writer drains on its own
+    const uint64_t request = ++m_FlushRequests;
+    m_WakeWriter.notify_one();
+    m_Flushed.wait(lock, [&]() { return m_FlushesDone >= request; });
+}
+
+void Logger::WriteFatal(const std::string& message) {
+    Flush();  // Everything logged before the fatal error comes first
+    std::cout << LevelPrefix(LogLevel::Fatal) << message << ANSI_RESET << std::endl;
+    std::abort();
+}
+
+void Logger::WriterLoop() {
+    std::unique_lock<std::mutex> lock(m_WriterMutex);
+    while (!m_Stop) {
+        m_WakeWriter.wait_for(lock, LOG_FLUSH_INTERVAL, [&]() { return m_Stop || m_FlushRequests > m_FlushesDone; });
+        const uint64_t request = m_FlushRequests;
+
+        lock.unlock();
+        Drain(false);
+        lock.lock();
+
+        m_FlushesDone = request;
+        m_Flushed.notify_all();
+    }
+
+    lock.unlock();
+    Drain(true);
+}
+
+void Logger::Drain(bool final) {
+    struct Line {
+        uint64_t time;
+        std::string text;
+    };
+    std::vector<Line> lines;
+
+    {
+        std::lock_guard<std::mutex> lock(m_BuffersMutex);
+        for (auto& buffer : m_Buffers) {
+            const uint64_t head = buffer->head.load(std::memory_order_acquire);
+            uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+            for (; tail < head; tail++) {
+                LogRecord& record = buffer->records[tail & (LOG_BUFFER_SIZE - 1)];
+
+                std::string text = LevelPrefix(record.level);
+                record.formatArgs(text, record.format, record.args);
+                if (record.suppressed > 0) text += std::format(" ({} similar messages suppressed)", record.suppressed);
+                text += ANSI_RESET "\n";
+                lines.push_back({record.time, std::move(text)});
+            }
+            buffer->tail.store(tail, std::memory_order_release);  // Hand the slots back to the owner
+        }
+    }
+
+    // Sites that went quiet since they were rate limited, their next message would have carried the count.
+    // The last drain reports them all.
+    const uint64_t now = Now();
+    for (LogSite* site = m_LimitedSites.load(std::memory_order_acquire); site != nullptr; site = site->next) {
+        if (!final && now - site->windowStart.load(std::memory_order_relaxed) < LOG_RATE_WINDOW_NS) continue;
+        const uint32_t suppressed = site->suppressed.exchange(0, std::memory_order_relaxed);
+        if (suppressed > 0) {
+            lines.push_back({now, std::format("{}\"{}\": {} similar messages suppressed" ANSI_RESET "\n", LevelPrefix(site->level), site->format, suppressed)});
+        }
+    }
+
+    const uint64_t dropped = m_Dropped.exchange(0, std::memory_order_relaxed);
+    if (lines.empty() && dropped == 0) return;
+
+    // Each ring is in order, merge them by time
+    std::stable_sort(lines.begin(), lines.end(), [](const Line& a, const Line& b) { return a.time < b.time; });
+    for (const auto& line : lines) std::cout << line.text;
+    if (dropped > 0) std::cout << LevelPrefix(LogLevel::Warning) << dropped << " log messages dropped, the log buffers were full" << ANSI_RESET "\n";
+    std::cout.flush();
+}
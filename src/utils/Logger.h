@@ -1,10 +1,65 @@
 #ifndef __LOGGER_H__
 #define __LOGGER_H__
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <format>
-#include <iostream>
+#include <memory>
 #include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
+enum class LogLevel : uint8_t { Trace = 0, Info, Warning, Error, Fatal };
+
+// Log sites below this level are compiled out, arguments included. Set from CMake with VOXELINITY_LOG_LEVEL (0 = trace ... 4 = fatal)
+#ifndef VOXELINITY_LOG_LEVEL
+#define VOXELINITY_LOG_LEVEL 0
+#endif
+constexpr LogLevel LOG_MIN_LEVEL = static_cast<LogLevel>(VOXELINITY_LOG_LEVEL);
+
+constexpr size_t LOG_BUFFER_SIZE = 1 << 10;                  // Records a thread can queue before the writer catches up, power of two
+constexpr size_t LOG_ARGS_SIZE = 128;                        // Captured arguments stored inline in a record
+constexpr uint32_t LOG_RATE_LIMIT = 20;                      // Messages per call site and per window, the rest are counted and dropped
+constexpr uint64_t LOG_RATE_WINDOW_NS = 1'000'000'000;       // 1 s
+constexpr std::chrono::milliseconds LOG_FLUSH_INTERVAL(5);  // Writer thread wake up period
+
+// Per call site state, one static instance per LOG_* expansion
+struct LogSite {
+    std::atomic<uint64_t> windowStart = 0;
+    std::atomic<uint32_t> count = 0;
+    std::atomic<uint32_t> suppressed = 0;  // Dropped since the last message that went through
+
+    // Set when the site is first rate limited, so the writer can report drops even if the site goes quiet
+    std::atomic<bool> listed = false;
+    LogSite* next = nullptr;
+    LogLevel level = LogLevel::Trace;
+    std::string_view format;
+};
+
+// A message waiting to be formatted: the format string and a copy of its arguments
+struct LogRecord {
+    LogLevel level;
+    uint32_t suppressed;     // Messages of the same site dropped by rate limiting right before this one
+    uint64_t time;           // Nanoseconds, orders the records of different threads
+    std::string_view format;  // String literal, never copied
+    void (*formatArgs)(std::string& out, std::string_view format, void* args);  // Formats the arguments then destroys them
+    alignas(std::max_align_t) std::byte args[LOG_ARGS_SIZE];
+};
+
+// Argument as stored in a record: strings are owned, since the caller's buffer is gone once the writer formats them
+template <typename T>
+using LogArg = std::conditional_t<std::is_convertible_v<std::decay_t<T>, std::string_view>, std::string, std::decay_t<T>>;
+
+// Callers only copy their arguments into a per-thread lock free ring. A background thread formats and writes them.
 class Logger {
    public:
     Logger(const Logger&) = delete;
@@ -15,66 +70,104 @@ class Logger {
 
     static Logger& Get();
 
-    template <typename... Args>
-    void Trace(const std::string_view& formatStr, Args&&... args);
-    template <typename... Args>
-    void Info(const std::string_view& formatStr, Args&&... args);
-    template <typename... Args>
-    void Warning(const std::string_view& formatStr, Args&&... args);
-    template <typename... Args>
-    void Error(const std::string_view& formatStr, Args&&... args);
-    template <typename... Args>
-    void Fatal(const std::string_view& formatStr, Args&&... args);
+    // Never blocks: the message is dropped when rate limited or when the thread's ring is full.
+    // The format string is checked against the arguments at compile time.
+    template <LogLevel Level, typename... Args>
+    void Log(LogSite& site, std::format_string<Args...> format, Args&&... args);
 
-   private:
-    Logger() = default;
-    ~Logger() = default;
+    // Blocks until every message queued before the call is written
+    void Flush();
 
    private:
-    std::mutex m_LoggerMutex;
-};
+    Logger();
+    ~Logger();
 
-#define ANSI_RESET "\033[0m"
-#define ANSI_RED "\033[31m"
-#define ANSI_GREEN "\033[32m"
-#define ANSI_YELLOW "\033[33m"
-#define ANSI_BLUE "\033[34m"
+    // Single producer ring: the owner thread writes and publishes head, the writer thread consumes and publishes tail
+    struct ThreadBuffer {
+        std::array<LogRecord, LOG_BUFFER_SIZE> records;
+        std::atomic<uint64_t> head = 0;
+        std::atomic<uint64_t> tail = 0;
+    };
 
-template <typename... Args>
-void Logger::Trace(const std::string_view& formatStr, Args&&... args) {
-    std::lock_guard<std::mutex> lock(m_LoggerMutex);
-    std::cout << ANSI_BLUE << "[TRACE] " << std::vformat(formatStr, std::make_format_args(args...)) << ANSI_RESET << "\n";
-}
+    template <typename Tuple>
+    static void FormatArgs(std::string& out, std::string_view format, void* args);
 
-template <typename... Args>
-void Logger::Info(const std::string_view& formatStr, Args&&... args) {
-    std::lock_guard<std::mutex> lock(m_LoggerMutex);
-    std::cout << ANSI_GREEN << "[INFO] " << std::vformat(formatStr, std::make_format_args(args...)) << ANSI_RESET << "\n";
-}
+    bool AcquireSite(LogSite& site, LogLevel level, std::string_view format, uint32_t& suppressed);
+    static uint64_t Now();
+    [[noreturn]] void WriteFatal(const std::string& message);
 
-template <typename... Args>
-void Logger::Warning(const std::string_view& formatStr, Args&&... args) {
-    std::lock_guard<std::mutex> lock(m_LoggerMutex);
-    std::cout << ANSI_YELLOW << "[WARNING] " << std::vformat(formatStr, std::make_format_args(args...)) << ANSI_RESET << "\n";
-}
+    ThreadBuffer* GetThreadBuffer();
+    LogRecord* BeginRecord(ThreadBuffer*& buffer);
+    void WriterLoop();
+    void Drain(bool final);
+
+    std::mutex m_BuffersMutex;  // Thread registration and draining, never taken by a caller once registered
+    std::vector<std::unique_ptr<ThreadBuffer>> m_Buffers;
+    std::atomic<uint64_t> m_Dropped;           // Records lost to full rings
+    std::atomic<LogSite*> m_LimitedSites;      // Intrusive list of the sites that hit the rate limit
+
+    std::thread m_Writer;
+    std::mutex m_WriterMutex;
+    std::condition_variable m_WakeWriter;
+    std::condition_variable m_Flushed;
+    uint64_t m_FlushRequests;
+    uint64_t m_FlushesDone;
+    bool m_Stop;
+};
 
-template <typename... Args>
-void Logger::Error(const std::string_view& formatStr, Args&&... args) {
-    std::lock_guard<std::mutex> lock(m_LoggerMutex);
-    std::cout << ANSI_RED << "[ERROR] " << std::vformat(formatStr, std::make_format_args(args...)) << ANSI_RESET << "\n";
+template <typename Tuple>
+void Logger::FormatArgs(std::string& out, std::string_view format, void* args) {
+    Tuple* tuple = std::launder(reinterpret_cast<Tuple*>(args));
+    std::apply([&](auto&... values) { std::vformat_to(std::back_inserter(out), format, std::make_format_args(values...)); }, *tuple);
+    tuple->~Tuple();
 }
 
-template <typename... Args>
-void Logger::Fatal(const std::string_view& formatStr, Args&&... args) {
-    std::lock_guard<std::mutex> lock(m_LoggerMutex);
-    std::cout << ANSI_RED << "[FATAL] " << std::vformat(formatStr, std::make_format_args(args...)) << ANSI_RESET << "\n";
-    std::abort();
+template <LogLevel Level, typename... Args>
+void Logger::Log(LogSite& site, std::format_string<Args...> format, Args&&... args) {
+    if constexpr (Level == LogLevel::Fatal) {
+        WriteFatal(std::vformat(format.get(), std::make_format_args(args...)));  // Synchronous, nothing runs after it
+    } else {
+        uint32_t suppressed = 0;
+        if (!AcquireSite(site, Level, format.get(), suppressed)) return;
+
+        ThreadBuffer* buffer = nullptr;
+        LogRecord* record = BeginRecord(buffer);
+        if (record == nullptr) return;
+
+        record->level = Level;
+        record->suppressed = suppressed;
+        record->time = Now();
+
+        using Tuple = std::tuple<LogArg<Args>...>;
+        if constexpr (sizeof(Tuple) <= LOG_ARGS_SIZE && alignof(Tuple) <= alignof(std::max_align_t)) {
+            new (record->args) Tuple(std::forward<Args>(args)...);
+            record->format = format.get();
+            record->formatArgs = &FormatArgs<Tuple>;
+        } else {
+            // Too large to store inline, format on the caller instead
+            using Formatted = std::tuple<std::string>;
+            new (record->args) Formatted(std::vformat(format.get(), std::make_format_args(args...)));
+            record->format = "{}";
+            record->formatArgs = &FormatArgs<Formatted>;
+        }
+
+        buffer->head.store(buffer->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);  // Publish to the writer
+    }
 }
 
-#define LOG_TRACE(...) Logger::Get().Trace(__VA_ARGS__)
-#define LOG_INFO(...) Logger::Get().Info(__VA_ARGS__)
-#define LOG_WARNING(...) Logger::Get().Warning(__VA_ARGS__)
-#define LOG_ERROR(...) Logger::Get().Error(__VA_ARGS__)
-#define LOG_FATAL(...) Logger::Get().Fatal(__VA_ARGS__)
+// A disabled site is a discarded statement: no code, no argument evaluation, no site state
+#define LOG_IMPL(level, ...)                                   \
+    do {                                                       \
+        if constexpr (level >= LOG_MIN_LEVEL) {                \
+            static LogSite s_LogSite;                          \
+            Logger::Get().Log<level>(s_LogSite, __VA_ARGS__); \
+        }                                                      \
+    } while (0)
+
+#define LOG_TRACE(...) LOG_IMPL(LogLevel::Trace, __VA_ARGS__)
+#define LOG_INFO(...) LOG_IMPL(LogLevel::Info, __VA_ARGS__)
+#define LOG_WARNING(...) LOG_IMPL(LogLevel::Warning, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_IMPL(LogLevel::Error, __VA_ARGS__)
+#define LOG_FATAL(...) LOG_IMPL(LogLevel::Fatal, __VA_ARGS__)
 
-#endif  // __LOGGER_H__
\ No newline at end of file
+#endif  // __LOGGER_H__
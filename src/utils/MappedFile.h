@@ -0,0 +1,32 @@
+#ifndef __MAPPED_FILE_H__
+#define __MAPPED_FILE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read only memory mapping of a whole file (mmap, MapViewOfFile on Windows)
+class MappedFile {
+   public:
+    MappedFile() = default;
+    ~MappedFile() { Unmap(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Replaces the current mapping, false if the file cannot be mapped or is empty
+    bool Map(const std::string& path);
+    void Unmap();
+
+    /* Getters */
+    const uint8_t* GetData() const { return m_Data; }
+    size_t GetSize() const { return m_Size; }
+
+   private:
+    const uint8_t* m_Data = nullptr;
+    size_t m_Size = 0;
+#ifdef _WIN32
+    void* m_Mapping = nullptr;  // HANDLE of the file mapping object
+#endif
+};
+
+#endif  // __MAPPED_FILE_H__
@@ -0,0 +1,169 @@
+#include "Profiler.h"
+
+#include <iomanip>
+
+#include "Logger.h"
+#include "pch.h"
+
+std::atomic<Profiler*> Profiler::m_Instance = nullptr;
+
+static const std::chrono::steady_clock::time_point s_Epoch = std::chrono::steady_clock::now();
+
+// Per thread recording state
+thread_local Profiler* t_Owner = nullptr;  // Profiler the cached buffer belongs to, re-registered after a restart
+thread_local void* t_Buffer = nullptr;
+thread_local std::string t_ThreadName;
+thread_local uint32_t t_Depth = 0;
+
+Profiler::Profiler() : m_MainThreadID(std::this_thread::get_id()), m_FrameStart(Now()), m_FrameMs(0.0), m_Capturing(false) {}
+
+void Profiler::Init() {
+    if (t_ThreadName.empty()) t_ThreadName = "Main";
+    m_Instance.store(new Profiler(), std::memory_order_release);
+}
+
+void Profiler::Shutdown() { delete m_Instance.exchange(nullptr, std::memory_order_acq_rel); }
+
+Profiler& Profiler::Get() {
+    Profiler* instance = TryGet();
+    assert(instance != nullptr);
+    return *instance;
+}
+
+uint64_t Profiler::Now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_Epoch).count());
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+    t_ThreadName = name;
+
+    Profiler* profiler = TryGet();
+    if (profiler != nullptr && t_Owner == profiler) {
+        std::lock_guard<std::mutex> lock(profiler->m_BuffersMutex);
+        static_cast<ThreadBuffer*>(t_Buffer)->name = name;
+    }
+}
+
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer() {
+    if (t_Owner == this) return static_cast<ThreadBuffer*>(t_Buffer);
+
+    // First zone of this thread, registration is the only locked step
+    std::lock_guard<std::mutex> lock(m_BuffersMutex);
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->tid = static_cast<uint32_t>(m_Buffers.size());
+    buffer->threadID = std::this_thread::get_id();
+    buffer->name = t_ThreadName.empty() ? "Thread " + std::to_string(buffer->tid) : t_ThreadName;
+
+    t_Owner = this;
+    t_Buffer = buffer.get();
+    m_Buffers.push_back(std::move(buffer));
+    return static_cast<ThreadBuffer*>(t_Buffer);
+}
+
+void Profiler::Record(const ProfileZone& zone) {
+    ThreadBuffer* buffer = GetThreadBuffer();
+    const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    buffer->zones[head & (PROFILER_BUFFER_SIZE - 1)] = zone;
+    buffer->head.store(head + 1, std::memory_order_release);  // Publish the zone to the drain
+}
+
+void Profiler::BeginFrame() { m_FrameStart = Now(); }
+
+void Profiler::EndFrame() {
+    const uint64_t frameEnd = Now();
+    m_FrameMs = static_cast<double>(frameEnd - m_FrameStart) / 1e6;
+    m_FrameZones.clear();
+    m_ThreadStats.clear();
+
+    std::unordered_map<std::string_view, size_t> zoneIndices;  // Zone name to its slot in m_FrameZones
+
+    std::lock_guard<std::mutex> lock(m_BuffersMutex);
+    for (auto& buffer : m_Buffers) {
+        const uint64_t head = buffer->head.load(std::memory_order_acquire);
+        // Only read the newest half of the ring, the owner keeps writing past head while we drain
+        const uint64_t oldest = head > PROFILER_BUFFER_SIZE / 2 ? head - PROFILER_BUFFER_SIZE / 2 : 0;
+        const bool isMainThread = buffer->threadID == m_MainThreadID;
+
+        ThreadStats stats = {buffer->name, 0.0, 0.0};
+        for (uint64_t i = std::max(buffer->tail, oldest); i < head; i++) {
+            const ProfileZone& zone = buffer->zones[i & (PROFILER_BUFFER_SIZE - 1)];
+
+            if (zone.depth == 0) {
+                const uint64_t start = std::max(zone.start, m_FrameStart);
+                const uint64_t end = std::min(zone.end, frameEnd);
+                if (end > start) stats.busyMs += static_cast<double>(end - start) / 1e6;
+            }
+
+            if (isMainThread) {
+                auto [it, inserted] = zoneIndices.try_emplace(zone.name, m_FrameZones.size());
+                if (inserted) m_FrameZones.push_back({zone.name, 0.0, 0});
+                m_FrameZones[it->second].totalMs += static_cast<double>(zone.end - zone.start) / 1e6;
+                m_FrameZones[it->second].calls++;
+            }
+
+            if (m_Capturing && m_Captured.size() < PROFILER_MAX_CAPTURED_ZONES) m_Captured.push_back({zone, buffer->tid});
+        }
+        buffer->tail = head;
+
+        stats.occupancy = m_FrameMs > 0.0 ? stats.busyMs / m_FrameMs : 0.0;
+        m_ThreadStats.push_back(stats);
+    }
+
+    std::sort(m_FrameZones.begin(), m_FrameZones.end(), [](const ZoneStats& a, const ZoneStats& b) { return a.totalMs > b.totalMs; });
+}
+
+void Profiler::StartCapture() {
+    m_Captured.clear();
+    m_Capturing = true;
+    LOG_INFO("Profiler: trace capture started");
+}
+
+static std::string EscapeJSON(const std::string& str) {
+    std::string escaped;
+    for (char c : str) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+bool Profiler::StopCapture(const std::string& path) {
+    m_Capturing = false;
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        LOG_ERROR("Profiler: cannot write the trace to '{0}'", path);
+        return false;
+    }
+
+    // Chrome trace event format, opens in chrome://tracing and ui.perfetto.dev
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    {
+        std::lock_guard<std::mutex> lock(m_BuffersMutex);
+        for (size_t i = 0; i < m_Buffers.size(); i++) {
+            file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << m_Buffers[i]->tid << ",\"args\":{\"name\":\""
+                 << EscapeJSON(m_Buffers[i]->name) << "\"}},\n";
+        }
+    }
+    file << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < m_Captured.size(); i++) {
+        const auto& [zone, tid] = m_Captured[i];
+        file << "{\"name\":\"" << EscapeJSON(zone.name) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+             << ",\"ts\":" << static_cast<double>(zone.start) / 1e3 << ",\"dur\":" << static_cast<double>(zone.end - zone.start) / 1e3 << "}"
+             << (i + 1 < m_Captured.size() ? ",\n" : "\n");
+    }
+    file << "]}\n";
+
+    LOG_INFO("Profiler: {0} zones written to '{1}'", m_Captured.size(), path);
+    m_Captured.clear();
+    m_Captured.shrink_to_fit();
+    return true;
+}
+
+/* ProfileScope */
+ProfileScope::ProfileScope(const char* name) : m_Name(name), m_Start(Profiler::Now()), m_Depth(t_Depth++) {}
+
+ProfileScope::~ProfileScope() {
+    t_Depth--;
+    if (Profiler* profiler = Profiler::TryGet()) profiler->Record({m_Name, m_Start, Profiler::Now(), m_Depth});
+}
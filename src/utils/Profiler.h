@@ -0,0 +1,124 @@
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+constexpr size_t PROFILER_BUFFER_SIZE = 1 << 14;         // Zones a thread can record between two drains, power of two
+constexpr size_t PROFILER_MAX_CAPTURED_ZONES = 1 << 21;  // Trace capture stops growing past this
+
+struct ProfileZone {
+    const char* name;  // String literal, never copied
+    uint64_t start;    // Nanoseconds since the profiler started
+    uint64_t end;
+    uint32_t depth;  // Nesting level on its thread, 0 for top level zones
+};
+
+// Time spent in a zone during the last frame, all calls on the main thread summed
+struct ZoneStats {
+    std::string name;
+    double totalMs;
+    uint32_t calls;
+};
+
+// Share of the last frame a thread spent inside top level zones (jobs for the workers)
+struct ThreadStats {
+    std::string name;
+    double busyMs;
+    double occupancy;
+};
+
+class Profiler {
+   public:
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    static void Init();
+    static void Shutdown();
+
+    static Profiler& Get();
+    static Profiler* TryGet() { return m_Instance.load(std::memory_order_acquire); }  // nullptr when not running
+
+    // Frame bounds, called by the main loop. EndFrame drains every thread buffer
+    void BeginFrame();
+    void EndFrame();
+
+    // Record every zone until StopCapture, which writes them as a Chrome trace / Perfetto JSON file
+    void StartCapture();
+    bool StopCapture(const std::string& path);
+
+    // Called by the recording thread only, lock free
+    void Record(const ProfileZone& zone);
+
+    static void SetThreadName(const std::string& name);
+    static uint64_t Now();
+
+    /* Getters */
+    bool IsCapturing() const { return m_Capturing; }
+    double GetFrameMs() const { return m_FrameMs; }
+    const std::vector<ZoneStats>& GetFrameZones() const { return m_FrameZones; }
+    const std::vector<ThreadStats>& GetThreadStats() const { return m_ThreadStats; }
+
+   private:
+    Profiler();
+    ~Profiler() = default;
+
+    // Single producer ring: the owner thread writes and publishes head, the main thread reads up to it
+    struct ThreadBuffer {
+        std::string name;
+        uint32_t tid;
+        std::thread::id threadID;
+        std::array<ProfileZone, PROFILER_BUFFER_SIZE> zones;
+        std::atomic<uint64_t> head = 0;  // Zones written so far
+        uint64_t tail = 0;               // Zones drained so far, main thread only
+    };
+
+    struct CapturedZone {
+        ProfileZone zone;
+        uint32_t tid;
+    };
+
+    ThreadBuffer* GetThreadBuffer();
+
+    std::mutex m_BuffersMutex;  // Thread registration and draining, never taken while recording
+    std::vector<std::unique_ptr<ThreadBuffer>> m_Buffers;
+    std::thread::id m_MainThreadID;
+
+    uint64_t m_FrameStart;
+    double m_FrameMs;
+    std::vector<ZoneStats> m_FrameZones;
+    std::vector<ThreadStats> m_ThreadStats;
+
+    bool m_Capturing;
+    std::vector<CapturedZone> m_Captured;
+
+    static std::atomic<Profiler*> m_Instance;
+};
+
+// Records the lifetime of the enclosing scope under 'name', which must be a string literal
+class ProfileScope {
+   public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope();
+
+   private:
+    const char* m_Name;
+    uint64_t m_Start;
+    uint32_t m_Depth;
+};
+
+#ifdef VOXELINITY_PROFILE
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name)
+#endif
+
+#endif  // __PROFILER_H__
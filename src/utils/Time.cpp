@@ -4,7 +4,7 @@
 
 Time* m_TimeInst = nullptr;
 
-Time::Time() : m_CurrentTime(0.0), m_LastTime(0.0), m_DeltaTime(0.0), m_FPS(0.0) {}
+Time::Time() : m_StartTime(std::chrono::steady_clock::now()), m_CurrentTime(0.0), m_LastTime(0.0), m_DeltaTime(0.0), m_FPS(0.0) {}
 
 void Time::Init() { m_TimeInst = new Time(); }
 
@@ -19,7 +19,7 @@ Time& Time::Get() {
 }
 
 void Time::Update() {
-    m_CurrentTime = glfwGetTime();
+    m_CurrentTime = GetCurrentTime();
 
     if (m_LastTime == 0) {
         m_LastTime = m_CurrentTime;
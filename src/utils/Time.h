@@ -1,14 +1,15 @@
 #ifndef __TIME_H__
 #define __TIME_H__
 
-#include "gfx/GraphicContext.h"
+#include <chrono>
 
 class Time {
    private:
     Time();
-    double m_CurrentTime;  // Actual time
-    double m_LastTime;     // Time since last call
-    double m_DeltaTime;    // Elapsed time between two frames in seconds
+    std::chrono::steady_clock::time_point m_StartTime;  // Time at init, independent of any window
+    double m_CurrentTime;                               // Actual time
+    double m_LastTime;                                  // Time since last call
+    double m_DeltaTime;                                 // Elapsed time between two frames in seconds
     double m_FPS;
 
    public:
@@ -21,9 +22,11 @@ class Time {
     void Update();
 
     /* Getters */
-    double GetCurrentTime() { return glfwGetTime(); }  // Get current time in second
-    double GetDeltaTime() { return m_DeltaTime; }      // Return delta time in second
-    double GetFPS() { return m_FPS; }                  // Return the number of frame per second
+    double GetCurrentTime() const {  // Get current time in second
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_StartTime).count();
+    }
+    double GetDeltaTime() { return m_DeltaTime; }  // Return delta time in second
+    double GetFPS() { return m_FPS; }              // Return the number of frame per second
 };
 
 #endif  // __TIME_H__
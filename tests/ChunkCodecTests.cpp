@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "app/ChunkCodec.h"
+
+constexpr size_t NB_FUZZ_CASES = 512;
+
+// Random runs of blocks, up to a random maximum length so payloads go from single voxel runs to full columns
+static void MakeFuzzChunk(std::mt19937& random, BlockArray& blocks) {
+    const int maxRun = std::uniform_int_distribution<int>(1, 64)(random);
+    std::uniform_int_distribution<int> run(1, maxRun);
+    std::bernoulli_distribution ground(std::uniform_real_distribution<double>(0.0, 1.0)(random));
+
+    size_t position = 0;
+    while (position < blocks.size()) {
+        const Block block = ground(random) ? Block::Ground : Block::Air;
+        const size_t end = std::min(blocks.size(), position + run(random));
+        for (; position < end; position++) blocks[position] = block;
+    }
+}
+
+static bool AreBlocksValid(const BlockArray& blocks) {
+    return std::all_of(blocks.begin(), blocks.end(), [](Block block) { return block == Block::Air || block == Block::Ground; });
+}
+
+// Random chunks round trip, truncated payloads never decode, and payloads with flipped bits either fail or decode to real
+// blocks (a flip can turn a chunk into another valid one)
+TEST(ChunkCodec_FuzzRoundTripAndCorruption) {
+    std::mt19937 random(1234);
+    BlockArray blocks;
+    BlockArray decoded;
+    std::vector<uint8_t> payload;
+    size_t nbMismatches = 0;
+    size_t nbTruncatedAccepted = 0;
+    size_t nbInvalidBlocks = 0;
+
+    for (size_t i = 0; i < NB_FUZZ_CASES; i++) {
+        MakeFuzzChunk(random, blocks);
+        payload.clear();
+        ChunkCodec::Encode(blocks, payload);
+        if (!ChunkCodec::Decode(payload.data(), payload.size(), decoded) || decoded != blocks) nbMismatches++;
+
+        std::vector<uint8_t> corrupted = payload;
+        const int nbFlips = std::uniform_int_distribution<int>(1, 4)(random);
+        for (int flip = 0; flip < nbFlips; flip++) {
+            corrupted[std::uniform_int_distribution<size_t>(0, corrupted.size() - 1)(random)] ^= 1 << (random() % 8);
+        }
+        if (ChunkCodec::Decode(corrupted.data(), corrupted.size(), decoded) && !AreBlocksValid(decoded)) nbInvalidBlocks++;
+
+        const size_t truncatedSize = std::uniform_int_distribution<size_t>(0, payload.size() - 1)(random);
+        if (ChunkCodec::Decode(payload.data(), truncatedSize, decoded)) nbTruncatedAccepted++;
+    }
+
+    EXPECT_EQ(nbMismatches, 0u);
+    EXPECT_EQ(nbTruncatedAccepted, 0u);
+    EXPECT_EQ(nbInvalidBlocks, 0u);
+}
+
+// Every palette byte past the last Block is rejected, in the current format and in version 1
+TEST(ChunkCodec_RejectsPaletteIdsThatAreNoBlock) {
+    BlockArray blocks;
+    std::mt19937 random(42);
+    MakeFuzzChunk(random, blocks);
+    std::vector<uint8_t> payload;
+    ChunkCodec::Encode(blocks, payload);
+
+    // Version 1: one Ground run over the whole chunk
+    std::vector<uint8_t> version1 = {1, 1, static_cast<uint8_t>(Block::Ground), 0, static_cast<uint8_t>(NB_VOXELS_IN_CHUNK & 0xFF),
+                                     static_cast<uint8_t>(NB_VOXELS_IN_CHUNK >> 8)};
+    BlockArray decoded;
+    ASSERT_TRUE(ChunkCodec::Decode(version1.data(), version1.size(), decoded));
+    EXPECT_TRUE(std::all_of(decoded.begin(), decoded.end(), [](Block block) { return block == Block::Ground; }));
+
+    const size_t paletteSize = static_cast<size_t>(payload[1]) + 1;
+    size_t nbAccepted = 0;
+    for (int id = static_cast<int>(Block::Ground) + 1; id < 256; id++) {
+        for (size_t entry = 0; entry < paletteSize; entry++) {
+            std::vector<uint8_t> corrupted = payload;
+            corrupted[2 + entry] = static_cast<uint8_t>(id);
+            nbAccepted += ChunkCodec::Decode(corrupted.data(), corrupted.size(), decoded);
+        }
+        version1[2] = static_cast<uint8_t>(id);
+        nbAccepted += ChunkCodec::Decode(version1.data(), version1.size(), decoded);
+    }
+    EXPECT_EQ(nbAccepted, 0u);
+}
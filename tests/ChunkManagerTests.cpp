@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include "Test.h"
+#include "app/ChunkManager.h"
+#include "app/RegionFile.h"
+#include "gfx/Renderable.h"
+
+constexpr int TEST_RENDER_DISTANCE = 3;
+
+// Updates the manager like frames do until every chunk in the render distance is generated and meshed
+static bool Settle(ChunkManager& chunks, const glm::ivec3& center) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    while (std::chrono::steady_clock::now() < deadline) {
+        chunks.Update();
+
+        bool settled = true;
+        for (int z = -TEST_RENDER_DISTANCE; z <= TEST_RENDER_DISTANCE && settled; z++) {
+            for (int x = -TEST_RENDER_DISTANCE; x <= TEST_RENDER_DISTANCE && settled; x++) {
+                const Chunk* chunk = chunks.GetChunk(center + glm::ivec3(x, 0, z));
+                settled = chunk != nullptr && chunk->IsDataGenerated() && chunk->IsMeshGenerated();
+            }
+        }
+        if (settled) return true;
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    return false;
+}
+
+// Chunks leaving the render distance and coming back are only saved when generated, the save already holds them after
+TEST(ChunkManager_UnloadSavesOnlyDirtyChunks) {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "voxelinity_tests_dirty_chunks";
+    std::filesystem::remove_all(directory);
+
+    {
+        ChunkManager chunks;
+        chunks.SetRenderDistance(TEST_RENDER_DISTANCE);
+        chunks.Init(directory.string());
+        ASSERT_TRUE(Settle(chunks, glm::ivec3(0)));
+
+        // Away and back: the chunks unloaded on the way are cold or saved copies, unchanged
+        for (int x = 1; x <= 2 * TEST_RENDER_DISTANCE; x++) {
+            chunks.SetCenter(glm::ivec3(x, 0, 0));
+            ASSERT_TRUE(Settle(chunks, glm::ivec3(x, 0, 0)));
+        }
+        for (int x = 2 * TEST_RENDER_DISTANCE - 1; x >= 0; x--) {
+            chunks.SetCenter(glm::ivec3(x, 0, 0));
+            ASSERT_TRUE(Settle(chunks, glm::ivec3(x, 0, 0)));
+        }
+    }  // Flushes the pending saves
+
+    // Each chunk written once leaves no dead bytes
+    size_t nbFiles = 0;
+    size_t deadBytes = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        auto file = RegionFile::Open(entry.path().string(), false);
+        ASSERT_TRUE(file != nullptr);
+        nbFiles++;
+        deadBytes += file->GetDeadBytes();
+    }
+    EXPECT_TRUE(nbFiles > 0);
+    EXPECT_EQ(deadBytes, 0u);
+
+    std::filesystem::remove_all(directory);
+}
+
+// Light sources above or below the chunks are dropped instead of lighting a voxel outside of them
+TEST(ChunkManager_IgnoresLightSourcesOutsideTheChunkHeight) {
+    ChunkManager chunks;
+    chunks.SetRenderDistance(TEST_RENDER_DISTANCE);
+    chunks.Init();
+    ASSERT_TRUE(Settle(chunks, glm::ivec3(0)));
+
+    chunks.SetLightSource(glm::ivec3(4, -1, 4), LIGHT_MAX);
+    chunks.SetLightSource(glm::ivec3(5, CHUNK_HEIGHT, 5), LIGHT_MAX);
+    chunks.SetLightSource(glm::ivec3(6, CHUNK_HEIGHT + 1000, 6), LIGHT_MAX);
+    chunks.SetLightSource(glm::ivec3(7, CHUNK_HEIGHT - 1, 7), LIGHT_MAX);  // Queued last, spread once the others would be
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (chunks.GetNbLightSources() == 0 && std::chrono::steady_clock::now() < deadline) {
+        chunks.Update();
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    EXPECT_EQ(chunks.GetNbLightSources(), 1u);
+}
+
+// What the renderer does at a frame: swaps in the meshes committed since the last one, checks them as an upload would
+// read them and frees them. Returns the number of swapped meshes
+static size_t DrawFrame(size_t& nbBadMeshes) {
+    size_t nbSwaps = 0;
+    for (Renderable* renderable : Renderable::GetRenderablesToDraw()) {
+        if (!renderable->SwapMesh()) continue;
+        nbSwaps++;
+
+        const auto vertices = renderable->GetVertices();
+        const auto indices = renderable->GetIndices();
+        const size_t nbVertices = vertices.size() / CHUNK_VERTEX_SIZE;
+        const bool valid = vertices.size() % CHUNK_VERTEX_SIZE == 0 && indices.size() % 3 == 0 &&
+                           std::all_of(indices.begin(), indices.end(), [nbVertices](uint32_t index) { return index < nbVertices; });
+        nbBadMeshes += !valid;
+        renderable->ReleaseCPUMesh();
+    }
+    return nbSwaps;
+}
+
+// Streaming while drawn: the center walks and torches are placed and removed along the way, so chunks are meshed,
+// relit and unloaded while frames swap their meshes in. Every swapped mesh must be whole, and once everything is drawn
+// no CPU mesh is left
+TEST(ChunkManager_StreamsWhileFramesSwapMeshes) {
+    size_t nbBadMeshes = 0;
+    size_t nbSwaps = 0;
+    {
+        ChunkManager chunks;
+        chunks.SetRenderDistance(TEST_RENDER_DISTANCE);
+        chunks.Init();
+
+        std::vector<glm::ivec3> torches;
+        for (int x = 0; x <= 2 * TEST_RENDER_DISTANCE; x++) {
+            const glm::ivec3 center(x, 0, x % 2);
+            chunks.SetCenter(center);
+
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+            bool settled = false;
+            while (!settled && std::chrono::steady_clock::now() < deadline) {
+                chunks.Update();
+                nbSwaps += DrawFrame(nbBadMeshes);
+                settled = chunks.GetChunk(center) != nullptr && chunks.GetChunk(center)->IsMeshGenerated();
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            ASSERT_TRUE(settled);
+
+            // A torch on top of the new center, the one placed two steps back goes out
+            torches.push_back(center * CHUNK_WIDTH + glm::ivec3(CHUNK_WIDTH / 2, CHUNK_HEIGHT - 1, CHUNK_WIDTH / 2));
+            chunks.SetLightSource(torches.back(), LIGHT_MAX);
+            if (torches.size() > 2) chunks.SetLightSource(torches[torches.size() - 3], 0);
+        }
+
+        ASSERT_TRUE(Settle(chunks, glm::ivec3(2 * TEST_RENDER_DISTANCE, 0, 0)));
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+        while (Renderable::GetResidentMeshBytes() > 0 && std::chrono::steady_clock::now() < deadline) {
+            chunks.Update();
+            nbSwaps += DrawFrame(nbBadMeshes);
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        EXPECT_EQ(Renderable::GetResidentMeshBytes(), 0u);
+        EXPECT_EQ(chunks.GetNbLightSources(), 2u);
+    }
+
+    EXPECT_TRUE(nbSwaps > 0);
+    EXPECT_EQ(nbBadMeshes, 0u);
+}
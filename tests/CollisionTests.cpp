@@ -0,0 +1,73 @@
+#include <cmath>
+#include <vector>
+
+#include "Test.h"
+#include "app/CollisionManager.h"
+#include "app/EntityStore.h"
+#include "app/Voxel.h"
+#include "app/VoxelGrid.h"
+
+constexpr int FLOOR_Y = 8;  // One voxel thick floor, its top at FLOOR_Y + 1
+constexpr int WALL_X = 20;  // One voxel thick wall standing on the floor
+constexpr float FRAME = 1.0f / 30.0f;
+constexpr float FLUSH_EPSILON = 1e-4f;
+
+// A floor and a wall, both thin enough for a fast entity to skip over them in a single frame without a sweep
+class ThinWalls : public VoxelGrid {
+   public:
+    ThinWalls() : m_Solid(glm::vec3(0.0f)) {}
+
+    Voxel* GetVoxel(const glm::vec3& pos) const override {
+        const int x = static_cast<int>(std::floor(pos.x)), y = static_cast<int>(std::floor(pos.y));
+        const bool floor = y == FLOOR_Y;
+        const bool wall = x == WALL_X && y > FLOOR_Y && y <= FLOOR_Y + 3;
+        return floor || wall ? &m_Solid : nullptr;
+    }
+
+   private:
+    mutable Voxel m_Solid;
+};
+
+static size_t SpawnPlayerSized(EntityStore& store, const glm::vec3& feet, const glm::vec3& velocity) {
+    const EntityID id = store.Create(glm::vec3(.6f, 1.8f, .6f), glm::vec3(.3f, 0.0f, .3f), feet, 0.0f);
+    const size_t index = store.GetIndex(id);
+    store.GetVelocities()[index] = velocity;
+    return index;
+}
+
+// 150 blocks/s toward the wall, 5 blocks in one 30 Hz frame: one sweep ends flush against its near face
+TEST(Collision_FastEntityStopsFlushAgainstThinWall) {
+    ThinWalls grid;
+    CollisionManager collisions(grid);
+    EntityStore store;
+    std::vector<Box> candidates;
+    const size_t index = SpawnPlayerSized(store, glm::vec3(WALL_X - 3.5f, FLOOR_Y + 1, 0.5f), glm::vec3(150.0f, 0.0f, 0.0f));
+
+    collisions.Sweep(store, index, FRAME, candidates);
+
+    const Box& box = store.GetBoxes()[index];
+    EXPECT_TRUE(std::abs(box.max.x - WALL_X) < FLUSH_EPSILON);
+    EXPECT_TRUE(std::abs(store.GetPositions()[index].x - (WALL_X - 0.3f)) < FLUSH_EPSILON);
+    EXPECT_EQ(store.GetVelocities()[index].x, 0.0f);
+
+    // Nothing left to resolve on the next frame
+    const glm::vec3 position = store.GetPositions()[index];
+    collisions.Sweep(store, index, FRAME, candidates);
+    EXPECT_TRUE(store.GetPositions()[index] == position);
+}
+
+// 120 blocks/s down, 4 blocks in one 30 Hz frame onto a one voxel floor: one sweep lands on it, grounded
+TEST(Collision_FastEntityLandsFlushOnThinFloor) {
+    ThinWalls grid;
+    CollisionManager collisions(grid);
+    EntityStore store;
+    std::vector<Box> candidates;
+    const size_t index = SpawnPlayerSized(store, glm::vec3(4.5f, FLOOR_Y + 2, 4.5f), glm::vec3(0.0f, -120.0f, 0.0f));
+
+    collisions.Sweep(store, index, FRAME, candidates);
+
+    EXPECT_TRUE(std::abs(store.GetBoxes()[index].min.y - (FLOOR_Y + 1)) < FLUSH_EPSILON);
+    EXPECT_TRUE(std::abs(store.GetPositions()[index].y - (FLOOR_Y + 1)) < FLUSH_EPSILON);
+    EXPECT_EQ(store.GetVelocities()[index].y, 0.0f);
+    EXPECT_TRUE(store.GetGrounded()[index] != 0);
+}
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Test.h"
+#include "app/Chunk.h"
+#include "app/LightEngine.h"
+#include "app/Noise.h"
+#include "app/RegionCache.h"
+
+constexpr int LIGHT_TEST_SIDE = 5;  // Chunks per side, the 3x3 area around the center chunk is all lit
+constexpr size_t NB_LIGHT_FUZZ_CASES = 64;
+
+// Generated terrain chunks, lit one by one as the mesh jobs do
+struct LitTerrain {
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    LightEngine engine;
+
+    LitTerrain() {
+        RegionCache regions{Noise()};
+        for (int z = 0; z < LIGHT_TEST_SIDE; z++) {
+            for (int x = 0; x < LIGHT_TEST_SIDE; x++) {
+                auto chunk = std::make_shared<Chunk>(glm::ivec3(x * CHUNK_WIDTH, 0, z * CHUNK_WIDTH));
+                chunk->GenerateData(*regions.GetRegion(x * CHUNK_WIDTH, z * CHUNK_WIDTH));
+                chunks.push_back(chunk);
+            }
+        }
+        for (int z = 0; z < LIGHT_TEST_SIDE; z++) {
+            for (int x = 0; x < LIGHT_TEST_SIDE; x++) engine.LightChunk(GetArea(x, z));
+        }
+        std::vector<std::weak_ptr<Chunk>> dirty;
+        engine.TakeDirtyChunks(dirty);
+    }
+    ~LitTerrain() {
+        for (auto& chunk : chunks) chunk->Unload();
+    }
+
+    ChunkArea GetArea(int chunkX, int chunkZ) const {
+        ChunkArea area;
+        for (int dz = -1; dz <= 1; dz++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                const int x = chunkX + dx, z = chunkZ + dz;
+                const bool inside = x >= 0 && x < LIGHT_TEST_SIDE && z >= 0 && z < LIGHT_TEST_SIDE;
+                area[(dz + 1) * LIGHT_AREA_SIZE + dx + 1] = inside ? chunks[z * LIGHT_TEST_SIDE + x] : nullptr;
+            }
+        }
+        return area;
+    }
+
+    // First air voxel above the ground of a world column
+    glm::ivec3 GetSurface(int worldX, int worldZ) const {
+        const Chunk& chunk = *chunks[(worldZ / CHUNK_WIDTH) * LIGHT_TEST_SIDE + worldX / CHUNK_WIDTH];
+        int y = 0;
+        while (y < CHUNK_HEIGHT - 1 && chunk.IsOpaque(Chunk::ToVoxelIndex(worldX % CHUNK_WIDTH, y, worldZ % CHUNK_WIDTH))) y++;
+        return glm::ivec3(worldX, y, worldZ);
+    }
+
+    std::vector<uint8_t> Snapshot() const {
+        std::vector<uint8_t> light;
+        light.reserve(chunks.size() * NB_VOXELS_IN_CHUNK);
+        for (const auto& chunk : chunks) {
+            for (int index = 0; index < NB_VOXELS_IN_CHUNK; index++) light.push_back(chunk->GetLight(index));
+        }
+        return light;
+    }
+};
+
+// Torches placed and removed at random around the center chunk. After each case the light must match placing only the
+// torches left on a fresh copy, and removing everything must give the starting light back
+TEST(LightEngine_FuzzTorchesMatchFreshPlacement) {
+    LitTerrain terrain;
+    LitTerrain reference;
+    const int center = LIGHT_TEST_SIDE / 2;
+    const ChunkArea area = terrain.GetArea(center, center);
+    const ChunkArea referenceArea = reference.GetArea(center, center);
+    const std::vector<uint8_t> baseline = terrain.Snapshot();
+    ASSERT_TRUE(baseline == reference.Snapshot());
+
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> column(center * CHUNK_WIDTH, (center + 1) * CHUNK_WIDTH - 1);
+    std::uniform_int_distribution<int> levelDistribution(1, LIGHT_MAX);
+    size_t nbMismatches = 0;
+    size_t nbNotRestored = 0;
+
+    for (size_t i = 0; i < NB_LIGHT_FUZZ_CASES; i++) {
+        std::vector<std::pair<glm::ivec3, uint8_t>> torches(4);
+        for (auto& [voxel, level] : torches) {
+            voxel = terrain.GetSurface(column(random), column(random));
+            voxel.y = std::min(voxel.y + static_cast<int>(random() % 3), CHUNK_HEIGHT - 1);
+            level = static_cast<uint8_t>(levelDistribution(random));
+        }
+        for (const auto& [voxel, level] : torches) terrain.engine.SetSource(area, voxel, level);
+        terrain.engine.SetSource(area, torches[0].first, 0);
+        terrain.engine.SetSource(area, torches[1].first, 0);
+
+        // Later torches at the same voxel replace the earlier ones
+        for (size_t t = 2; t < torches.size(); t++) {
+            const bool removed = torches[t].first == torches[0].first || torches[t].first == torches[1].first;
+            reference.engine.SetSource(referenceArea, torches[t].first, removed ? 0 : torches[t].second);
+        }
+        if (terrain.Snapshot() != reference.Snapshot()) nbMismatches++;
+
+        for (const auto& [voxel, level] : torches) {
+            terrain.engine.SetSource(area, voxel, 0);
+            reference.engine.SetSource(referenceArea, voxel, 0);
+        }
+        if (terrain.Snapshot() != baseline) nbNotRestored++;
+    }
+
+    EXPECT_EQ(nbMismatches, 0u);
+    EXPECT_EQ(nbNotRestored, 0u);
+    EXPECT_EQ(terrain.engine.GetNbSources(), 0u);
+}
@@ -0,0 +1,35 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "Test.h"
+#include "app/Noise.h"
+
+// Tiles of every kernel this CPU runs against single GetNoise samples, bit for bit: a kernel change must not move the
+// terrain. Odd sizes reach the scalar tails, negative origins the floor of negative coordinates
+TEST(Noise_TilesMatchSingleSamples) {
+    struct Tile {
+        int originX, originZ, width, depth;
+    };
+    const Tile tiles[] = {{0, 0, 16, 16}, {-16, -16, 16, 16}, {-1000, -37, 129, 65}, {12345, -9876, 128, 128}, {-3, 5, 7, 3}, {-70001, 70001, 255, 9}};
+
+    for (int backend = 0; backend <= static_cast<int>(Noise::GetBestBackend()); backend++) {
+        for (const auto& [seed, frequency] : {std::pair{1337, 0.01f}, std::pair{-42, 0.0371f}}) {
+            Noise noise(seed, frequency);
+            noise.SetBackend(static_cast<Noise::Backend>(backend));
+
+            size_t nbMismatches = 0;
+            for (const auto& tile : tiles) {
+                std::vector<float> values(tile.width * tile.depth);
+                noise.GenerateTile(tile.originX, tile.originZ, tile.width, tile.depth, values.data());
+                for (int z = 0; z < tile.depth; z++) {
+                    for (int x = 0; x < tile.width; x++) {
+                        const float expected = noise.GetNoise(static_cast<float>(tile.originX + x), static_cast<float>(tile.originZ + z));
+                        nbMismatches += std::memcmp(&expected, &values[z * tile.width + x], sizeof(float)) != 0;
+                    }
+                }
+            }
+            if (!EXPECT_EQ(nbMismatches, 0u)) std::printf("    %s kernel, seed %d\n", Noise::GetBackendName(noise.GetBackend()), seed);
+        }
+    }
+}
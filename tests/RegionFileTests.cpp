@@ -0,0 +1,106 @@
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Test.h"
+#include "app/ChunkCodec.h"
+#include "app/RegionFile.h"
+#include "app/RegionStore.h"
+
+// Scratch directory removed before and after each test
+class ScratchDirectory {
+   public:
+    ScratchDirectory(const std::string& name) : m_Path(std::filesystem::temp_directory_path() / ("voxelinity_tests_" + name)) {
+        std::filesystem::remove_all(m_Path);
+        std::filesystem::create_directories(m_Path);
+    }
+    ~ScratchDirectory() {
+        std::error_code error;
+        std::filesystem::remove_all(m_Path, error);
+    }
+
+    std::string GetFile(const std::string& name) const { return (m_Path / name).string(); }
+    const std::filesystem::path& GetPath() const { return m_Path; }
+
+   private:
+    std::filesystem::path m_Path;
+};
+
+// Ground columns of random heights with random holes, so payloads differ and do not all compress to a few bytes
+static void RandomBlocks(std::mt19937& random, BlockArray& blocks) {
+    std::uniform_int_distribution<int> height(0, CHUNK_HEIGHT);
+    std::bernoulli_distribution hole(0.02);
+    for (int z = 0; z < CHUNK_WIDTH; z++) {
+        for (int x = 0; x < CHUNK_WIDTH; x++) {
+            const int top = height(random);
+            for (int y = 0; y < CHUNK_HEIGHT; y++) blocks[Chunk::ToVoxelIndex(x, y, z)] = y < top && !hole(random) ? Block::Ground : Block::Air;
+        }
+    }
+}
+
+// Rewrites read back right away through the lazily remapped file, then after compaction and after reopening
+TEST(RegionFile_RoundTripThroughRewritesAndCompaction) {
+    ScratchDirectory directory("region_file");
+    const std::string path = directory.GetFile("r.0.0.vxr");
+    constexpr int NB_CHUNKS = 16;
+    constexpr int NB_ROUNDS = 8;
+
+    std::mt19937 random(7);
+    std::vector<BlockArray> expected(NB_CHUNKS);
+    auto file = RegionFile::Open(path, true);
+    ASSERT_TRUE(file != nullptr);
+
+    size_t nbMismatches = 0;
+    bool compacted = false;
+    BlockArray blocks;
+    for (int round = 0; round < NB_ROUNDS; round++) {
+        for (int i = 0; i < NB_CHUNKS; i++) {
+            const int index = i * 37 % NB_CHUNKS_IN_REGION_FILE;
+            RandomBlocks(random, expected[i]);
+            std::vector<uint8_t> payload;
+            ChunkCodec::Encode(expected[i], payload);
+            ASSERT_TRUE(file->WriteChunk(index, payload));
+            nbMismatches += !file->ReadChunk(index, blocks) || blocks != expected[i];
+        }
+        if (file->NeedsCompaction()) {
+            ASSERT_TRUE(file->Compact());
+            EXPECT_EQ(file->GetDeadBytes(), 0u);
+            compacted = true;
+        }
+        for (int i = 0; i < NB_CHUNKS; i++) nbMismatches += !file->ReadChunk(i * 37 % NB_CHUNKS_IN_REGION_FILE, blocks) || blocks != expected[i];
+    }
+    EXPECT_TRUE(compacted);
+    EXPECT_TRUE(!file->ReadChunk(1, blocks));  // Never written
+
+    file.reset();
+    file = RegionFile::Open(path, false);
+    ASSERT_TRUE(file != nullptr);
+    for (int i = 0; i < NB_CHUNKS; i++) nbMismatches += !file->ReadChunk(i * 37 % NB_CHUNKS_IN_REGION_FILE, blocks) || blocks != expected[i];
+    EXPECT_EQ(nbMismatches, 0u);
+}
+
+// Saves are served while pending, then read back from disk by another store, negative coordinates included
+TEST(RegionStore_SavesReadBackAfterReopening) {
+    ScratchDirectory directory("region_store");
+    std::mt19937 random(11);
+    const glm::ivec2 coords[] = {{0, 0}, {-1, -1}, {31, 32}, {-33, 5}, {100, -100}};
+    std::vector<BlockArray> expected(std::size(coords));
+
+    size_t nbMismatches = 0;
+    BlockArray blocks;
+    {
+        RegionStore store(directory.GetPath().string());
+        for (size_t i = 0; i < std::size(coords); i++) {
+            RandomBlocks(random, expected[i]);
+            store.Save(coords[i], expected[i]);
+            nbMismatches += !store.Load(coords[i], blocks) || blocks != expected[i];
+        }
+        store.Flush();
+    }
+
+    RegionStore store(directory.GetPath().string());
+    for (size_t i = 0; i < std::size(coords); i++) nbMismatches += !store.Load(coords[i], blocks) || blocks != expected[i];
+    EXPECT_TRUE(!store.Load(glm::ivec2(2, 2), blocks));
+    EXPECT_EQ(nbMismatches, 0u);
+}
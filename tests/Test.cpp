@@ -0,0 +1,82 @@
+#include "Test.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "core/ThreadPool.h"
+#include "events/EventDispatcher.h"
+#include "utils/Logger.h"
+
+namespace test {
+
+struct TestCase {
+    std::string name;
+    TestFunction function;
+};
+
+static std::vector<TestCase>& GetRegistry() {
+    static std::vector<TestCase> s_Registry;
+    return s_Registry;
+}
+
+static size_t s_NbFailures = 0;  // Of the running test
+
+bool RegisterTest(const std::string& name, TestFunction function) {
+    GetRegistry().push_back({name, function});
+    return true;
+}
+
+void ReportFailure(const char* file, int line, const std::string& message) {
+    std::printf("  %s:%d: %s\n", file, line, message.c_str());
+    s_NbFailures++;
+}
+
+int RunTests(int argc, char** argv) {
+    std::string filter;
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--filter=", 9) == 0) {
+            filter = argv[i] + 9;
+        } else {
+            std::fprintf(stderr, "Usage: %s [--filter=<substring>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    size_t nbRun = 0;
+    std::vector<std::string> failed;
+    for (const auto& testCase : GetRegistry()) {
+        if (!filter.empty() && testCase.name.find(filter) == std::string::npos) continue;
+
+        std::printf("[ RUN  ] %s\n", testCase.name.c_str());
+        std::fflush(stdout);
+        s_NbFailures = 0;
+        testCase.function();
+        nbRun++;
+        if (s_NbFailures > 0) failed.push_back(testCase.name);
+        std::printf("[ %s ] %s\n", s_NbFailures > 0 ? "FAIL" : " OK ", testCase.name.c_str());
+        std::fflush(stdout);
+    }
+
+    std::printf("%zu tests, %zu failed\n", nbRun, failed.size());
+    for (const auto& name : failed) std::printf("  %s\n", name.c_str());
+    return failed.empty() ? 0 : 1;
+}
+
+}  // namespace test
+
+int main(int argc, char** argv) {
+    Logger::Init();
+    EventDispatcher::Init();
+    ThreadPoolProps threadPoolProps;
+    threadPoolProps.nbReservedThreads = 0;
+    ThreadPool::Init(threadPoolProps);
+
+    int result = test::RunTests(argc, argv);
+
+    ThreadPool::Shutdown();
+    EventDispatcher::Shutdown();
+    Logger::Shutdown();
+    return result;
+}
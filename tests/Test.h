@@ -0,0 +1,50 @@
+#ifndef __TEST_H__
+#define __TEST_H__
+
+#include <sstream>
+#include <string>
+
+namespace test {
+
+using TestFunction = void (*)();
+
+bool RegisterTest(const std::string& name, TestFunction function);
+void ReportFailure(const char* file, int line, const std::string& message);  // Fails the running test, it keeps going
+int RunTests(int argc, char** argv);
+
+// Printed value of a checked expression, "?" for types without operator<<
+template <class T>
+std::string ToString(const T& value) {
+    if constexpr (requires(std::ostream& stream) { stream << value; }) {
+        std::ostringstream stream;
+        stream << value;
+        return stream.str();
+    } else {
+        return "?";
+    }
+}
+
+template <class A, class B>
+bool CheckEqual(const A& a, const B& b, const char* expressions, const char* file, int line) {
+    if (a == b) return true;
+    ReportFailure(file, line, std::string(expressions) + " (" + ToString(a) + " vs " + ToString(b) + ")");
+    return false;
+}
+
+}  // namespace test
+
+#define TEST(name)                                                    \
+    static void name();                                               \
+    static bool s_Registered##name = test::RegisterTest(#name, name); \
+    static void name()
+
+// EXPECT_* fail the test and keep going, ASSERT_* also return from it
+#define EXPECT_TRUE(condition) \
+    ((condition) ? true : (test::ReportFailure(__FILE__, __LINE__, "EXPECT_TRUE(" #condition ")"), false))
+#define EXPECT_EQ(a, b) test::CheckEqual((a), (b), "EXPECT_EQ(" #a ", " #b ")", __FILE__, __LINE__)
+#define ASSERT_TRUE(condition) \
+    if (!EXPECT_TRUE(condition)) return
+#define ASSERT_EQ(a, b) \
+    if (!EXPECT_EQ(a, b)) return
+
+#endif  // __TEST_H__
@@ -0,0 +1,70 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "Test.h"
+#include "core/ThreadPool.h"
+
+// Every range of a ParallelFor is visited once, whatever the grain
+TEST(ThreadPool_ParallelForCoversEveryItem) {
+    for (size_t grainSize : {1, 7, 64, 1000}) {
+        std::vector<std::atomic<int>> visits(1000);
+        ThreadPool::Get().ParallelFor(visits.size(), grainSize, [&visits](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) visits[i].fetch_add(1, std::memory_order_relaxed);
+        });
+
+        size_t nbWrong = 0;
+        for (const auto& visit : visits) nbWrong += visit.load() != 1;
+        EXPECT_EQ(nbWrong, 0u);
+    }
+}
+
+TEST(ThreadPool_CounterWaitsForItsJobs) {
+    ThreadPool pool(4);
+    std::atomic<int> nbDone = 0;
+    JobCounter counter;
+    for (int i = 0; i < 256; i++) pool.Enqueue(counter, [&nbDone]() { nbDone.fetch_add(1, std::memory_order_relaxed); });
+    counter.Wait();
+    EXPECT_EQ(nbDone.load(), 256);
+}
+
+// A lane without workers hands its jobs to the other one
+TEST(ThreadPool_EmptyLaneIsRouted) {
+    ThreadPool pool(1);
+    std::atomic<bool> ran = false;
+    pool.Enqueue(JobLane::Meshing, [&ran]() { ran = true; });
+    JobCounter counter;
+    pool.Enqueue(counter, []() {});  // Queued behind it on the same worker
+    counter.Wait();
+    EXPECT_TRUE(ran.load());
+}
+
+// ParallelFor helpers are taken by the workers of any lane: with the meshing worker stuck in a long job, a generation
+// worker still helps. Each of the two ranges waits for the other to start, so the caller alone would time out
+TEST(ThreadPool_ParallelForIsHelpedByEveryLane) {
+    ThreadPoolProps props;
+    props.nbThreads = 2;
+    props.nbMeshingThreads = 1;
+    ThreadPool pool(props);
+
+    std::atomic<bool> blocked = false;
+    std::atomic<bool> release = false;
+    pool.Enqueue(JobLane::Meshing, [&blocked, &release]() {
+        blocked = true;
+        while (!release.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+    while (!blocked.load()) std::this_thread::yield();
+
+    std::atomic<int> nbStarted = 0;
+    std::atomic<int> nbMet = 0;
+    pool.ParallelFor(2, 1, [&nbStarted, &nbMet](size_t, size_t) {
+        nbStarted.fetch_add(1);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (nbStarted.load() < 2 && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+        if (nbStarted.load() == 2) nbMet.fetch_add(1);
+    });
+    release = true;
+
+    EXPECT_EQ(nbMet.load(), 2);
+}